@@ -0,0 +1,108 @@
+#include <algorithm>
+#include <cassert>
+#include "GFArena.h"
+
+/**
+ * Default constructor, of an empty arena.
+ */
+GFArena::GFArena() : _block(0), _offset(0), _blockAllocations(0)
+{}
+
+/**
+ * Destructor, frees all the blocks.
+ */
+GFArena::~GFArena()
+{
+    for (char *block : _blocks)
+    {
+        delete[] block;
+    }
+}
+
+/**
+ * @return The arena of the calling thread, valid until the thread ends.
+ */
+GFArena& GFArena::local()
+{
+    thread_local GFArena arena;
+    return arena;
+}
+
+/**
+ * Hands out memory from the current block, or from the next block that is large enough. When no
+ * block is, a new one of at least twice the size of the last one is allocated.
+ * @param bytes The amount of bytes.
+ * @param align The alignment, a power of 2 that isn't bigger than the alignment of new.
+ * @return Uninitialized memory, valid until the arena is reset or rewound before it.
+ */
+void *GFArena::allocate(const size_t& bytes, const size_t& align)
+{
+    assert(align > 0 && (align & (align - 1)) == 0 && align <= alignof(std::max_align_t));
+    while (_block < _blocks.size())
+    {
+        size_t start = (_offset + align - 1) & ~(align - 1);
+        if (start + bytes <= _sizes[_block])
+        {
+            _offset = start + bytes;
+            return _blocks[_block] + start;
+        }
+        _block++;
+        _offset = 0;
+    }
+    size_t size = std::max(_sizes.empty() ? ARENA_FIRST_BLOCK : 2 * _sizes.back(), bytes);
+    _blocks.push_back(new char[size]);
+    _sizes.push_back(size);
+    _blockAllocations++;
+    _block = _blocks.size() - 1;
+    _offset = bytes;
+    return _blocks.back();
+}
+
+/**
+ * @return The current position of the arena.
+ */
+GFArena::Mark GFArena::getMark() const
+{
+    return {_block, _offset};
+}
+
+/**
+ * Frees everything that was allocated after the given mark.
+ * @param mark A mark of this arena, from before the allocations to free.
+ */
+void GFArena::rewind(const Mark& mark)
+{
+    assert(mark.block < _block || (mark.block == _block && mark.offset <= _offset));
+    _block = mark.block;
+    _offset = mark.offset;
+}
+
+/**
+ * Frees everything that was allocated, and keeps the blocks for the next allocations.
+ */
+void GFArena::reset()
+{
+    _block = 0;
+    _offset = 0;
+}
+
+/**
+ * @return The amount of blocks that were allocated from the heap.
+ */
+const long& GFArena::getBlockAllocations() const
+{
+    return _blockAllocations;
+}
+
+/**
+ * @return The total size of the blocks, in bytes.
+ */
+size_t GFArena::getCapacity() const
+{
+    size_t capacity = 0;
+    for (const size_t& size : _sizes)
+    {
+        capacity += size;
+    }
+    return capacity;
+}
@@ -0,0 +1,108 @@
+#ifndef EX1_GFARENA_H
+#define EX1_GFARENA_H
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Defines the size of the first block of an arena, in bytes.
+ */
+const size_t ARENA_FIRST_BLOCK = 1 << 16;
+
+/**
+ * GFArena class, memory that is handed out by bumping an offset in large blocks and is freed all
+ * at once - by reset, or by rewind to an earlier mark. The blocks are kept after they are freed,
+ * so a thread that repeats the same work stops allocating from the heap once its arena is large
+ * enough.
+ * Only trivially destructible objects may be kept in it, since they are never destroyed.
+ */
+class GFArena
+{
+private:
+    std::vector<char *> _blocks;
+    std::vector<size_t> _sizes;
+    size_t _block, _offset;
+    long _blockAllocations;
+
+public:
+    /**
+     * A position in the arena, everything allocated after it is freed by rewinding to it.
+     */
+    struct Mark
+    {
+        size_t block, offset;
+    };
+
+    /**
+     * Default constructor, of an empty arena.
+     */
+    GFArena();
+
+    /**
+     * The blocks are owned by the arena, so it can't be copied.
+     */
+    GFArena(const GFArena& other) = delete;
+
+    /**
+     * The blocks are owned by the arena, so it can't be assigned.
+     */
+    GFArena& operator=(const GFArena& other) = delete;
+
+    /**
+     * Destructor, frees all the blocks.
+     */
+    ~GFArena();
+
+    /**
+     * @return The arena of the calling thread, valid until the thread ends.
+     */
+    static GFArena& local();
+
+    /**
+     * @param bytes The amount of bytes.
+     * @param align The alignment, a power of 2 that isn't bigger than the alignment of new.
+     * @return Uninitialized memory, valid until the arena is reset or rewound before it.
+     */
+    void *allocate(const size_t& bytes, const size_t& align);
+
+    /**
+     * @param n The amount of objects.
+     * @return Uninitialized memory for n objects of type T, which must be constructed in place.
+     */
+    template <typename T>
+    T *allocate(const size_t& n)
+    {
+        static_assert(std::is_trivially_destructible<T>::value,
+                      "The objects of an arena are never destroyed");
+        return static_cast<T *>(allocate(n * sizeof(T), alignof(T)));
+    }
+
+    /**
+     * @return The current position of the arena.
+     */
+    Mark getMark() const;
+
+    /**
+     * Frees everything that was allocated after the given mark.
+     * @param mark A mark of this arena, from before the allocations to free.
+     */
+    void rewind(const Mark& mark);
+
+    /**
+     * Frees everything that was allocated, and keeps the blocks for the next allocations.
+     */
+    void reset();
+
+    /**
+     * @return The amount of blocks that were allocated from the heap.
+     */
+    const long& getBlockAllocations() const;
+
+    /**
+     * @return The total size of the blocks, in bytes.
+     */
+    size_t getCapacity() const;
+};
+
+#endif //EX1_GFARENA_H
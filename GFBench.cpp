@@ -0,0 +1,500 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <new>
+#include <poll.h>
+#include <random>
+#include <signal.h>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+#include "GFMatrix.h"
+#include "GFNumber.h"
+
+#ifndef GF_BUILD_TYPE
+#define GF_BUILD_TYPE ""
+#endif
+
+/**
+ * Defines the amount of inputs every size class has.
+ */
+const size_t BENCH_INPUTS = 256;
+
+/**
+ * Defines the minimal duration of a timed batch of calls, so the clock overhead is negligible.
+ */
+const double BENCH_MIN_BATCH_NS = 2000;
+
+/**
+ * Defines the maximal amount of calls in a timed batch.
+ */
+const long BENCH_MAX_BATCH = 1 << 20;
+
+/**
+ * Defines the default time every benchmark runs, in seconds.
+ */
+const double BENCH_DEFAULT_BUDGET = 0.2;
+
+/**
+ * Defines the default time a benchmark may take before it's stopped, in seconds.
+ */
+const double BENCH_DEFAULT_TIMEOUT = 5;
+
+/**
+ * Defines the char of the field whose arithmetic is checked before the benchmarks - the largest
+ * prime below 2**63, where sums and differences of residues don't fit in a long.
+ */
+const long CHECK_LARGE_CHAR = 9223372036854775783L;
+
+/**
+ * The results of one benchmark, passed from the process that ran it.
+ */
+struct BenchResult
+{
+    double nsPerOp, opsPerSec, p50, p90, p99, min, max, allocsPerOp;
+    long samples, ops;
+};
+
+/**
+ * The inputs of one size class.
+ */
+struct SizeClass
+{
+    std::string name;
+    GField field;
+    std::vector<GFNumber> a, b, ints;
+    std::vector<long> raw;
+};
+
+/**
+ * A single benchmark - an operation on the inputs of a size class.
+ */
+struct BenchCase
+{
+    std::string op;
+    const SizeClass *cls;
+    std::function<long(const size_t&)> run;
+};
+
+/**
+ * Keeps the results of the benchmarked calls alive, so they aren't optimized away.
+ */
+static volatile long benchSink = 0;
+
+/**
+ * Counts the heap allocations of the whole program.
+ */
+static std::atomic<long> heapAllocations(0);
+
+/**
+ * Allocates from the heap, and counts the allocation.
+ * @param size The amount of bytes.
+ * @return The allocated memory.
+ */
+void *operator new(size_t size)
+{
+    heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    void *res = std::malloc((size == 0) ? 1 : size);
+    if (res == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return res;
+}
+
+/**
+ * Frees memory of operator new.
+ * @param ptr The memory.
+ */
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+/**
+ * Frees memory of operator new.
+ * @param ptr The memory.
+ */
+void operator delete(void *ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+/**
+ * Draws a random prime with the given amount of bits.
+ * @param gen The random generator.
+ * @param bits The amount of bits of the prime.
+ * @return The prime.
+ */
+static long randomPrime(std::mt19937_64& gen, const int& bits)
+{
+    std::uniform_int_distribution<long> dist(1L << (bits - 1), (1L << bits) - 1);
+    long p;
+    do
+    {
+        p = dist(gen) | 1;
+    } while (!GField::isPrime(p));
+    return p;
+}
+
+/**
+ * Builds a size class, with random field members and the given integers.
+ * @param name The name of the class.
+ * @param field The field of the class.
+ * @param raw The integers the primality, gcd and factorization benchmarks use.
+ * @param gen The random generator.
+ * @return The size class.
+ */
+static SizeClass makeClass(const std::string& name, const GField& field,
+                           const std::vector<long>& raw, std::mt19937_64& gen)
+{
+    SizeClass cls{name, field, {}, {}, {}, raw};
+    std::uniform_int_distribution<long> dist(1, field.getOrder() - 1);
+    for (size_t i = 0; i < BENCH_INPUTS; i++)
+    {
+        cls.a.push_back(field.createNumber(dist(gen)));
+        cls.b.push_back(field.createNumber(dist(gen)));
+        cls.ints.push_back(field.createNumber(raw[i % raw.size()]));
+    }
+    return cls;
+}
+
+/**
+ * Builds all the size classes - tiny, small, 32-bit, 48-bit semiprimes, 62-bit semiprimes and
+ * prime powers.
+ * @return The size classes.
+ */
+static std::vector<SizeClass> makeClasses()
+{
+    std::mt19937_64 gen(1);
+    std::vector<SizeClass> classes;
+    std::vector<long> raw;
+    std::uniform_int_distribution<long> tiny(2, 250);
+    for (size_t i = 0; i < BENCH_INPUTS; i++)
+    {
+        raw.push_back(tiny(gen));
+    }
+    classes.push_back(makeClass("tiny", GField(251), raw, gen));
+    raw.clear();
+    std::uniform_int_distribution<long> small(2, (1L << 16) - 1);
+    for (size_t i = 0; i < BENCH_INPUTS; i++)
+    {
+        raw.push_back(small(gen));
+    }
+    classes.push_back(makeClass("small", GField(65521), raw, gen));
+    raw.clear();
+    std::uniform_int_distribution<long> word(1L << 31, (1L << 32) - 1);
+    for (size_t i = 0; i < BENCH_INPUTS; i++)
+    {
+        raw.push_back(word(gen));
+    }
+    classes.push_back(makeClass("32bit", GField(4294967291L), raw, gen));
+    raw.clear();
+    for (size_t i = 0; i < BENCH_INPUTS; i++)
+    {
+        raw.push_back(randomPrime(gen, 24) * randomPrime(gen, 24));
+    }
+    classes.push_back(makeClass("semiprime48", GField(281474976710597L), raw, gen));
+    raw.clear();
+    for (size_t i = 0; i < BENCH_INPUTS; i++)
+    {
+        raw.push_back(randomPrime(gen, 31) * randomPrime(gen, 31));
+    }
+    classes.push_back(makeClass("semiprime62", GField(4611686018427387847L), raw, gen));
+    raw.clear();
+    const long bases[] = {2, 3, 5, 7, 11, 13};
+    const long exponents[] = {30, 19, 13, 11, 8, 8};
+    for (size_t i = 0; i < BENCH_INPUTS; i++)
+    {
+        long power = 1;
+        for (long j = 0; j < exponents[i % 6] - (long) (i / 6 % 4); j++)
+        {
+            power *= bases[i % 6];
+        }
+        raw.push_back(power);
+    }
+    classes.push_back(makeClass("primepower", GField(3, 20), raw, gen));
+    return classes;
+}
+
+/**
+ * Builds the benchmarks of every operation on every size class.
+ * @param classes The size classes.
+ * @return The benchmarks.
+ */
+static std::vector<BenchCase> makeCases(const std::vector<SizeClass>& classes)
+{
+    std::vector<BenchCase> cases;
+    for (const SizeClass& c : classes)
+    {
+        const SizeClass *cls = &c;
+        cases.push_back({"add", cls, [cls](const size_t& i)
+        {
+            return (cls->a[i] + cls->b[i]).getNumber();
+        }});
+        cases.push_back({"sub", cls, [cls](const size_t& i)
+        {
+            return (cls->a[i] - cls->b[i]).getNumber();
+        }});
+        cases.push_back({"mul", cls, [cls](const size_t& i)
+        {
+            return (cls->a[i] * cls->b[i]).getNumber();
+        }});
+        cases.push_back({"mod", cls, [cls](const size_t& i)
+        {
+            return (cls->a[i] % cls->b[i]).getNumber();
+        }});
+        cases.push_back({"isPrime", cls, [cls](const size_t& i)
+        {
+            return (long) GField::isPrime(cls->raw[i % cls->raw.size()]);
+        }});
+        cases.push_back({"gcd", cls, [cls](const size_t& i)
+        {
+            const GFNumber& x = cls->ints[i];
+            const GFNumber& y = cls->ints[(i + 1) % BENCH_INPUTS];
+            return cls->field.gcd(x, y).getNumber();
+        }});
+        cases.push_back({"factor", cls, [cls](const size_t& i)
+        {
+            int arrLength = 0;
+            GFNumber *primeFactors = cls->ints[i].getPrimeFactors(&arrLength);
+            delete[] primeFactors;
+            return (long) arrLength;
+        }});
+        cases.push_back({"factorArena", cls, [cls](const size_t& i)
+        {
+            GFArena& arena = GFArena::local();
+            int arrLength = 0;
+            cls->ints[i].getPrimeFactors(&arrLength, arena);
+            arena.reset();
+            return (long) arrLength;
+        }});
+    }
+    return cases;
+}
+
+/**
+ * Checks the matrix addition, subtraction and residue normalization of GF(CHECK_LARGE_CHAR)
+ * against 128-bit reference values, so an overflow there fails the benchmark run.
+ * @return true if all the results are right, false otherwise.
+ */
+static bool checkLargeField()
+{
+    const long p = CHECK_LARGE_CHAR;
+    const long values[] = {0, 1, 2, p / 2, p / 2 + 1, p - 2, p - 1};
+    const long n = sizeof(values) / sizeof(values[0]);
+    GField f(p);
+    GFMatrix a(f, n, n), b(f, n, n);
+    for (long i = 0; i < n; i++)
+    {
+        for (long j = 0; j < n; j++)
+        {
+            a.setResidue(i, j, values[i]);
+            b.setResidue(i, j, values[j]);
+        }
+    }
+    GFMatrix sum = a + b, difference = a - b;
+    for (long i = 0; i < n; i++)
+    {
+        for (long j = 0; j < n; j++)
+        {
+            __int128 x = values[i], y = values[j];
+            if (sum.getResidue(i, j) != (long) ((x + y) % p) ||
+                difference.getResidue(i, j) != (long) ((x - y + p) % p))
+            {
+                return false;
+            }
+        }
+    }
+    const long residues[] = {LONG_MIN, LONG_MIN + 1, -p, -1, p, LONG_MAX};
+    for (const long& k : residues)
+    {
+        a.setResidue(0, 0, k);
+        if (a.getResidue(0, 0) != (long) (((__int128) k % p + p) % p))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Runs the given benchmark for the given time, in batches of calls. The heap allocations are
+ * counted after the batch size is calibrated, so they show the steady state.
+ * @param bench The benchmark to run.
+ * @param budget The time to run, in seconds.
+ * @return The results.
+ */
+static BenchResult measure(const BenchCase& bench, const double& budget)
+{
+    size_t next = 0;
+    long sink = 0;
+    std::function<double(const long&)> batch = [&](const long& calls)
+    {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (long j = 0; j < calls; j++)
+        {
+            sink += bench.run(next);
+            next = (next + 1) % BENCH_INPUTS;
+        }
+        std::chrono::duration<double, std::nano> took = std::chrono::steady_clock::now() - start;
+        return took.count();
+    };
+    long calls = 1;
+    double took;
+    while ((took = batch(calls)) < BENCH_MIN_BATCH_NS && calls < BENCH_MAX_BATCH)
+    {
+        calls *= 2;
+    }
+    std::vector<double> samples = {took / calls};
+    double total = took;
+    long ops = calls, steadyOps = 0, allocations = 0;
+    do
+    {
+        long before = heapAllocations.load(std::memory_order_relaxed);
+        took = batch(calls);
+        allocations += heapAllocations.load(std::memory_order_relaxed) - before;
+        samples.push_back(took / calls);
+        total += took;
+        ops += calls;
+        steadyOps += calls;
+    } while (total < budget * 1e9);
+    benchSink = sink;
+    std::sort(samples.begin(), samples.end());
+    std::function<double(const double&)> percentile = [&samples](const double& q)
+    {
+        return samples[std::min(samples.size() - 1, (size_t) (q * samples.size()))];
+    };
+    return {total / ops, ops * 1e9 / total, percentile(0.5), percentile(0.9), percentile(0.99),
+            samples.front(), samples.back(), (double) allocations / steadyOps,
+            (long) samples.size(), ops};
+}
+
+/**
+ * Runs the given benchmark in a child process, and stops it if it takes too long.
+ * @param bench The benchmark to run.
+ * @param budget The time to run, in seconds.
+ * @param timeout The time after which the benchmark is stopped, in seconds.
+ * @param res Reference to the results.
+ * @return "ok" if the benchmark finished in time, "timeout" if it was stopped, and "failed" if
+ * the child process died.
+ */
+static const char *runIsolated(const BenchCase& bench, const double& budget, const double& timeout,
+                        BenchResult& res)
+{
+    int fds[2];
+    if (pipe(fds) != 0)
+    {
+        return "failed";
+    }
+    std::cout.flush();
+    pid_t pid = fork();
+    if (pid == 0)
+    {
+        close(fds[0]);
+        BenchResult measured = measure(bench, budget);
+        ssize_t done = write(fds[1], &measured, sizeof(measured));
+        _exit(done == sizeof(measured) ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+    close(fds[1]);
+    struct pollfd polled = {fds[0], POLLIN, 0};
+    const char *status = "failed";
+    if (pid > 0 && poll(&polled, 1, (int) (timeout * 1000)) == 0)
+    {
+        status = "timeout";
+    }
+    else if (pid > 0 && read(fds[0], &res, sizeof(res)) == sizeof(res))
+    {
+        status = "ok";
+    }
+    close(fds[0]);
+    if (pid > 0)
+    {
+        kill(pid, SIGKILL);
+        waitpid(pid, nullptr, 0);
+    }
+    return status;
+}
+
+/**
+ * Runs the benchmarks and prints their results as JSON.
+ * usage: gf_bench [--budget seconds] [--timeout seconds] [--filter text]
+ * Every benchmark runs in its own process, so a call that takes longer than the timeout is
+ * reported with a "timeout" status instead of stalling the whole run.
+ * @return EXIT_FAILURE if the arguments are invalid, EXIT_SUCCESS otherwise.
+ */
+int main(int argc, char *argv[])
+{
+    double budget = BENCH_DEFAULT_BUDGET;
+    double timeout = BENCH_DEFAULT_TIMEOUT;
+    std::string filter;
+    for (int i = 1; i < argc; i++)
+    {
+        if (i + 1 < argc && std::strcmp(argv[i], "--budget") == 0)
+        {
+            budget = std::atof(argv[++i]);
+        }
+        else if (i + 1 < argc && std::strcmp(argv[i], "--timeout") == 0)
+        {
+            timeout = std::atof(argv[++i]);
+        }
+        else if (i + 1 < argc && std::strcmp(argv[i], "--filter") == 0)
+        {
+            filter = argv[++i];
+        }
+        else
+        {
+            std::cerr << "usage: gf_bench [--budget seconds] [--timeout seconds] [--filter text]"
+                      << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    if (!checkLargeField())
+    {
+        std::cerr << "gf_bench: wrong matrix arithmetic in GF(" << CHECK_LARGE_CHAR << ")"
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::vector<SizeClass> classes = makeClasses();
+    std::vector<BenchCase> cases = makeCases(classes);
+#ifdef NDEBUG
+    const char *asserts = "false";
+#else
+    const char *asserts = "true";
+#endif
+    std::cout << "{\n  \"build\": {\"compiler\": \"" << __VERSION__ << "\", \"build_type\": \""
+              << GF_BUILD_TYPE << "\", \"asserts\": " << asserts << "},\n  \"results\": [";
+    std::cout << std::fixed << std::setprecision(2);
+    bool first = true;
+    for (const BenchCase& bench : cases)
+    {
+        std::string name = bench.op + "/" + bench.cls->name;
+        if (name.find(filter) == std::string::npos)
+        {
+            continue;
+        }
+        BenchResult res;
+        std::string status = runIsolated(bench, budget, timeout, res);
+        std::cout << (first ? "\n" : ",\n") << "    {\"op\": \"" << bench.op << "\", \"class\": \""
+                  << bench.cls->name << "\", \"status\": \"" << status << "\"";
+        if (status == "ok")
+        {
+            std::cout << ", \"ns_per_op\": " << res.nsPerOp << ", \"ops_per_sec\": "
+                      << res.opsPerSec << ", \"p50_ns\": " << res.p50 << ", \"p90_ns\": "
+                      << res.p90 << ", \"p99_ns\": " << res.p99 << ", \"min_ns\": " << res.min
+                      << ", \"max_ns\": " << res.max << ", \"samples\": " << res.samples
+                      << ", \"ops\": " << res.ops << ", \"allocs_per_op\": " << res.allocsPerOp;
+        }
+        std::cout << "}";
+        std::cout.flush();
+        first = false;
+    }
+    std::cout << "\n  ]\n}" << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,356 @@
+#include <cassert>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "GFBinary.h"
+
+/**
+ * Defines the magic bytes every binary file starts with.
+ */
+const char GF_BINARY_MAGIC[4] = {'G', 'F', 'B', 'N'};
+
+/**
+ * Defines the size of the encoded header in bytes.
+ */
+const size_t GF_BINARY_HEADER_SIZE = 32;
+
+/**
+ * Stores the given value in little-endian order.
+ * @param dst The bytes to store the value in.
+ * @param value The value to store.
+ * @param width The amount of bytes to store.
+ */
+static inline void storeLittle(unsigned char *dst, uint64_t value, const unsigned int& width)
+{
+    for (unsigned int i = 0; i < width; i++)
+    {
+        dst[i] = static_cast<unsigned char>(value);
+        value >>= 8;
+    }
+}
+
+/**
+ * Loads a value that is stored in little-endian order.
+ * @param src The bytes the value is stored in.
+ * @param width The amount of bytes to load.
+ * @return The loaded value.
+ */
+static inline uint64_t loadLittle(const unsigned char *src, const unsigned int& width)
+{
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    switch (width)
+    {
+        case 1:
+            return *src;
+        case 2:
+        {
+            uint16_t value;
+            std::memcpy(&value, src, sizeof(value));
+            return value;
+        }
+        case 4:
+        {
+            uint32_t value;
+            std::memcpy(&value, src, sizeof(value));
+            return value;
+        }
+        default:
+        {
+            uint64_t value;
+            std::memcpy(&value, src, sizeof(value));
+            return value;
+        }
+    }
+#else
+    uint64_t value = 0;
+    for (unsigned int i = width; i > 0; i--)
+    {
+        value = (value << 8) | src[i - 1];
+    }
+    return value;
+#endif
+}
+
+/**
+ * Finds the width of the words that can hold every residue of the given field.
+ * @param f The field of the residues.
+ * @return The smallest of 1, 2, 4 or 8 bytes that fits the field order.
+ */
+static unsigned int residueWidth(const GField& f)
+{
+    uint64_t largest = f.getOrder() - 1;
+    unsigned int width = 1;
+    while (width < sizeof(uint64_t) && (largest >> (8 * width)) != 0)
+    {
+        width *= 2;
+    }
+    return width;
+}
+
+/**
+ * Constructor that creates (or truncates) the given file.
+ * @param path The path of the file to write.
+ * @param f The GField of all the written numbers.
+ * @param kind The kind of the file content.
+ */
+GFBinaryWriter::GFBinaryWriter(const char *path, const GField& f, const GFBinaryKind& kind) :
+        _f(f), _kind(kind), _fd(open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644)),
+        _width(residueWidth(f)), _count(0)
+{
+    if (_fd < 0)
+    {
+        return;
+    }
+    unsigned char header[GF_BINARY_HEADER_SIZE] = {};
+    _out.reset(new GFWriter(_fd));
+    _out->write(reinterpret_cast<const char *>(header), GF_BINARY_HEADER_SIZE);
+}
+
+/**
+ * Destructor for the GFBinaryWriter object, closes the file.
+ */
+GFBinaryWriter::~GFBinaryWriter()
+{
+    close();
+}
+
+/**
+ * @return true if the file was opened, false otherwise.
+ */
+bool GFBinaryWriter::isOpen() const
+{
+    return _out != nullptr;
+}
+
+/**
+ * Adds the given word to the body in little-endian order.
+ * @param word The word to add.
+ */
+void GFBinaryWriter::_writeWord(const uint64_t& word)
+{
+    unsigned char bytes[sizeof(uint64_t)];
+    storeLittle(bytes, word, _width);
+    _out->write(reinterpret_cast<const char *>(bytes), _width);
+    _count++;
+}
+
+/**
+ * Adds the given GFNumber to a NUMBERS file.
+ * @param num The number to add, must be of the writer's field.
+ */
+void GFBinaryWriter::write(const GFNumber& num)
+{
+    assert(num.getField() == _f);
+    writeResidue(num.getNumber());
+}
+
+/**
+ * Adds the given residue to a NUMBERS file.
+ * @param n The residue to add, must be in the writer's field.
+ */
+void GFBinaryWriter::writeResidue(const long& n)
+{
+    assert(isOpen() && _kind == GFBinaryKind::NUMBERS);
+    assert(n >= 0 && n < _f.getOrder());
+    _writeWord(n);
+}
+
+/**
+ * Adds the factorization of the given GFNumber to a FACTORS file.
+ * The record is the residue, the factors amount and then the prime factors, one word each.
+ * @param num The number to factorize, must be of the writer's field.
+ */
+void GFBinaryWriter::writeFactors(const GFNumber& num)
+{
+    assert(isOpen() && _kind == GFBinaryKind::FACTORS);
+    assert(num.getField() == _f);
+    int arrLength = 0;
+    GFArena& arena = GFArena::local();
+    GFArena::Mark mark = arena.getMark();
+    GFNumber *primeFactors = num.getPrimeFactors(&arrLength, arena);
+    _writeWord(num.getNumber());
+    _writeWord(arrLength);
+    for (int i = 0; i < arrLength; i++)
+    {
+        _writeWord(primeFactors[i].getNumber());
+    }
+    arena.rewind(mark);
+}
+
+/**
+ * Flushes the body and completes the header, no more numbers can be added after it. A failed
+ * write leaves a header that GFBinaryView rejects, so it's reported here.
+ * @return true if the whole file was written, false if a write failed or it was not open.
+ */
+bool GFBinaryWriter::close()
+{
+    if (!isOpen())
+    {
+        return false;
+    }
+    _out->flush();
+    bool written = !_out->fail();
+    _out.reset();
+    unsigned char header[GF_BINARY_HEADER_SIZE] = {};
+    std::memcpy(header, GF_BINARY_MAGIC, sizeof(GF_BINARY_MAGIC));
+    storeLittle(header + 4, GF_BINARY_VERSION, 2);
+    header[6] = static_cast<unsigned char>(_kind);
+    header[7] = static_cast<unsigned char>(_width);
+    storeLittle(header + 8, _f.getChar(), 8);
+    storeLittle(header + 16, _f.getDegree(), 8);
+    storeLittle(header + 24, _count, 8);
+    ssize_t done = pwrite(_fd, header, GF_BINARY_HEADER_SIZE, 0);
+    while (done < 0 && errno == EINTR)
+    {
+        done = pwrite(_fd, header, GF_BINARY_HEADER_SIZE, 0);
+    }
+    written = written && done == (ssize_t) GF_BINARY_HEADER_SIZE;
+    written = ::close(_fd) == 0 && written;
+    _fd = -1;
+    return written;
+}
+
+/**
+ * Constructor that maps the given file.
+ * @param path The path of the file to read.
+ */
+GFBinaryView::GFBinaryView(const char *path) : _kind(GFBinaryKind::NUMBERS), _map(nullptr),
+                                               _body(nullptr), _mapSize(0), _count(0), _width(1)
+{
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        return;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < (off_t) GF_BINARY_HEADER_SIZE)
+    {
+        ::close(fd);
+        return;
+    }
+    void *map = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED)
+    {
+        return;
+    }
+    _map = static_cast<const unsigned char *>(map);
+    _mapSize = info.st_size;
+    long p = loadLittle(_map + 8, 8);
+    long l = loadLittle(_map + 16, 8);
+    _width = _map[7];
+    _count = loadLittle(_map + 24, 8);
+    bool valid = std::memcmp(_map, GF_BINARY_MAGIC, sizeof(GF_BINARY_MAGIC)) == 0 &&
+                 loadLittle(_map + 4, 2) == GF_BINARY_VERSION && _map[6] <= 1 &&
+                 (_width == 1 || _width == 2 || _width == 4 || _width == 8) &&
+                 _count <= (_mapSize - GF_BINARY_HEADER_SIZE) / _width &&
+                 GField::isValid(p, l);
+    if (!valid)
+    {
+        munmap(map, _mapSize);
+        _map = nullptr;
+        return;
+    }
+    _f = GField(p, l);
+    _kind = static_cast<GFBinaryKind>(_map[6]);
+    _body = _map + GF_BINARY_HEADER_SIZE;
+}
+
+/**
+ * Destructor for the GFBinaryView object, unmaps the file.
+ */
+GFBinaryView::~GFBinaryView()
+{
+    if (_map != nullptr)
+    {
+        munmap(const_cast<unsigned char *>(_map), _mapSize);
+    }
+}
+
+/**
+ * @return true if the file was mapped and its header is valid, false otherwise.
+ */
+bool GFBinaryView::isValid() const
+{
+    return _map != nullptr;
+}
+
+/**
+ * @return The GField of the numbers in the file.
+ */
+const GField& GFBinaryView::getField() const
+{
+    return _f;
+}
+
+/**
+ * @return The kind of the file content.
+ */
+GFBinaryKind GFBinaryView::getKind() const
+{
+    return _kind;
+}
+
+/**
+ * @return The amount of words in the body.
+ */
+size_t GFBinaryView::size() const
+{
+    return _count;
+}
+
+/**
+ * @param i The index of the word to read.
+ * @return The residue stored in the i'th word.
+ */
+long GFBinaryView::getResidue(const size_t& i) const
+{
+    assert(i < _count);
+    return loadLittle(_body + i * _width, _width);
+}
+
+/**
+ * @param i The index of the word to read.
+ * @return The GFNumber stored in the i'th word.
+ */
+GFNumber GFBinaryView::getNumber(const size_t& i) const
+{
+    return _f.createNumber(getResidue(i));
+}
+
+/**
+ * Reads the factorization record that starts at the given position of a FACTORS file, in the
+ * same form getPrimeFactors returns it. The file may be corrupt, so a record that doesn't fit in
+ * the body is rejected.
+ * @param pos Reference to the position of the record, moved to the next record.
+ * @param num Reference to the GFNumber the record belongs to.
+ * @param arrLength The array length pointer, set to 0 if the record is invalid.
+ * @return A dynamic allocated array of the prime factors, nullptr if the record is invalid.
+ */
+GFNumber *GFBinaryView::readFactors(size_t& pos, GFNumber& num, int *arrLength) const
+{
+    assert(_kind == GFBinaryKind::FACTORS);
+    *arrLength = 0;
+    if (pos + 1 >= _count)
+    {
+        return nullptr;
+    }
+    long count = getResidue(pos + 1);
+    if (count < 0 || (size_t) count > _count - pos - 2 || count > INT_MAX)
+    {
+        return nullptr;
+    }
+    num = getNumber(pos);
+    *arrLength = (int) count;
+    GFNumber *result = new GFNumber[*arrLength];
+    for (int i = 0; i < *arrLength; i++)
+    {
+        result[i] = getNumber(pos + 2 + i);
+    }
+    pos += 2 + *arrLength;
+    return result;
+}
@@ -0,0 +1,183 @@
+#ifndef EX1_GFBINARY_H
+#define EX1_GFBINARY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "GFNumber.h"
+#include "GFWriter.h"
+
+/**
+ * Defines the version of the binary format that is written.
+ */
+const uint16_t GF_BINARY_VERSION = 1;
+
+/**
+ * The kinds of content a binary file can hold.
+ * NUMBERS - a packed array of residues.
+ * FACTORS - records of a residue, its factors amount and its prime factors.
+ */
+enum class GFBinaryKind : uint8_t
+{
+    NUMBERS = 0,
+    FACTORS = 1
+};
+
+/**
+ * GFBinaryWriter class, that streams residues of one GField, or their factorizations, into a
+ * binary file.
+ * The file starts with a 32 bytes little-endian header - the magic "GFBN", the version (2 bytes),
+ * the kind (1 byte), the word width (1 byte), the field char, the field degree and the amount of
+ * words in the body (8 bytes each). The body is that amount of little-endian words, each one of
+ * the smallest of 1, 2, 4 or 8 bytes that fits every residue of the field.
+ */
+class GFBinaryWriter
+{
+private:
+    GField _f;
+    GFBinaryKind _kind;
+    int _fd;
+    std::unique_ptr<GFWriter> _out;
+    unsigned int _width;
+    uint64_t _count;
+
+    /**
+     * Adds the given word to the body in little-endian order.
+     * @param word The word to add.
+     */
+    void _writeWord(const uint64_t& word);
+
+public:
+    /**
+     * Constructor that creates (or truncates) the given file.
+     * @param path The path of the file to write.
+     * @param f The GField of all the written numbers.
+     * @param kind The kind of the file content.
+     */
+    GFBinaryWriter(const char *path, const GField& f, const GFBinaryKind& kind);
+
+    /**
+     * The writer owns its file, so it can't be copied.
+     */
+    GFBinaryWriter(const GFBinaryWriter& other) = delete;
+
+    /**
+     * Destructor for the GFBinaryWriter object, closes the file.
+     */
+    ~GFBinaryWriter();
+
+    /**
+     * The writer owns its file, so it can't be assigned.
+     */
+    GFBinaryWriter& operator=(const GFBinaryWriter& other) = delete;
+
+    /**
+     * @return true if the file was opened, false otherwise.
+     */
+    bool isOpen() const;
+
+    /**
+     * Adds the given GFNumber to a NUMBERS file.
+     * @param num The number to add, must be of the writer's field.
+     */
+    void write(const GFNumber& num);
+
+    /**
+     * Adds the given residue to a NUMBERS file.
+     * @param n The residue to add, must be in the writer's field.
+     */
+    void writeResidue(const long& n);
+
+    /**
+     * Adds the factorization of the given GFNumber to a FACTORS file.
+     * @param num The number to factorize, must be of the writer's field.
+     */
+    void writeFactors(const GFNumber& num);
+
+    /**
+     * Flushes the body and completes the header, no more numbers can be added after it.
+     * @return true if the whole file was written, false if a write failed or it was not open.
+     */
+    bool close();
+};
+
+/**
+ * GFBinaryView class, that maps a binary file into memory and reads its residues in place.
+ */
+class GFBinaryView
+{
+private:
+    GField _f;
+    GFBinaryKind _kind;
+    const unsigned char *_map;
+    const unsigned char *_body;
+    size_t _mapSize;
+    size_t _count;
+    unsigned int _width;
+
+public:
+    /**
+     * Constructor that maps the given file.
+     * @param path The path of the file to read.
+     */
+    GFBinaryView(const char *path);
+
+    /**
+     * The view owns its mapping, so it can't be copied.
+     */
+    GFBinaryView(const GFBinaryView& other) = delete;
+
+    /**
+     * Destructor for the GFBinaryView object, unmaps the file.
+     */
+    ~GFBinaryView();
+
+    /**
+     * The view owns its mapping, so it can't be assigned.
+     */
+    GFBinaryView& operator=(const GFBinaryView& other) = delete;
+
+    /**
+     * @return true if the file was mapped and its header is valid, false otherwise.
+     */
+    bool isValid() const;
+
+    /**
+     * @return The GField of the numbers in the file.
+     */
+    const GField& getField() const;
+
+    /**
+     * @return The kind of the file content.
+     */
+    GFBinaryKind getKind() const;
+
+    /**
+     * @return The amount of words in the body.
+     */
+    size_t size() const;
+
+    /**
+     * @param i The index of the word to read.
+     * @return The residue stored in the i'th word.
+     */
+    long getResidue(const size_t& i) const;
+
+    /**
+     * @param i The index of the word to read.
+     * @return The GFNumber stored in the i'th word.
+     */
+    GFNumber getNumber(const size_t& i) const;
+
+    /**
+     * Reads the factorization record that starts at the given position of a FACTORS file, in the
+     * same form getPrimeFactors returns it.
+     * @param pos Reference to the position of the record, moved to the next record.
+     * @param num Reference to the GFNumber the record belongs to.
+     * @param arrLength The array length pointer, set to 0 if the record is invalid.
+     * @return A dynamic allocated array of the prime factors, nullptr if the record is invalid.
+     */
+    GFNumber *readFactors(size_t& pos, GFNumber& num, int *arrLength) const;
+};
+
+#endif //EX1_GFBINARY_H
@@ -0,0 +1,69 @@
+#include <cstdlib>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include "GFServer.h"
+#include "GFWriter.h"
+
+/**
+ * Defines the amount of bytes copied at once.
+ */
+const size_t CLIENT_BLOCK_SIZE = 1 << 16;
+
+/**
+ * Sends all the standard input to the server, and then closes the sending side of the socket.
+ * @param fd The connected socket.
+ */
+static void sendInput(const int fd)
+{
+    char buffer[CLIENT_BLOCK_SIZE];
+    ssize_t got;
+    while ((got = read(STDIN_FILENO, buffer, CLIENT_BLOCK_SIZE)) > 0)
+    {
+        for (ssize_t sent = 0; sent < got;)
+        {
+            ssize_t done = send(fd, buffer + sent, got - sent, MSG_NOSIGNAL);
+            if (done <= 0)
+            {
+                shutdown(fd, SHUT_WR);
+                return;
+            }
+            sent += done;
+        }
+    }
+    shutdown(fd, SHUT_WR);
+}
+
+/**
+ * Runs the daemon client - sends the requests from the standard input, one per line, to the
+ * daemon and prints its answers.
+ * usage: GFClient <socket path>
+ * @return EXIT_FAILURE if the arguments are invalid or the daemon is unreachable, EXIT_SUCCESS
+ * otherwise.
+ */
+int main(int argc, char *argv[])
+{
+    if (argc < 2)
+    {
+        std::cerr << "usage: GFClient <socket path>" << std::endl;
+        return EXIT_FAILURE;
+    }
+    int fd = GFServer::connectTo(argv[1]);
+    if (fd < 0)
+    {
+        std::cerr << "can't connect to " << argv[1] << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::thread sender(sendInput, fd);
+    GFWriter& out = GFWriter::local();
+    char buffer[CLIENT_BLOCK_SIZE];
+    ssize_t got;
+    while ((got = read(fd, buffer, CLIENT_BLOCK_SIZE)) > 0)
+    {
+        out.write(buffer, got);
+    }
+    sender.join();
+    out.flush();
+    close(fd);
+    return EXIT_SUCCESS;
+}
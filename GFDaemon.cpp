@@ -0,0 +1,46 @@
+#include <csignal>
+#include <cstdlib>
+#include <thread>
+#include "GFServer.h"
+
+/**
+ * The server that the signal handler stops.
+ */
+static GFServer *runningServer = nullptr;
+
+/**
+ * Stops the running server.
+ * @param signal The received signal.
+ */
+static void stopServer(int signal)
+{
+    (void) signal;
+    if (runningServer != nullptr)
+    {
+        runningServer->stop();
+    }
+}
+
+/**
+ * Runs the factorization daemon - serves requests on the given Unix domain socket until it gets
+ * SIGINT or SIGTERM.
+ * usage: GFDaemon <socket path> [workers]
+ * @return EXIT_FAILURE if the arguments are invalid or the socket can't be bound, EXIT_SUCCESS
+ * otherwise.
+ */
+int main(int argc, char *argv[])
+{
+    if (argc < 2)
+    {
+        std::cerr << "usage: GFDaemon <socket path> [workers]" << std::endl;
+        return EXIT_FAILURE;
+    }
+    int workers = (argc > 2) ? std::atoi(argv[2]) : (int) std::thread::hardware_concurrency();
+    GFServer server(argv[1], workers);
+    runningServer = &server;
+    std::signal(SIGINT, stopServer);
+    std::signal(SIGTERM, stopServer);
+    bool served = server.run();
+    runningServer = nullptr;
+    return served ? EXIT_SUCCESS : EXIT_FAILURE;
+}
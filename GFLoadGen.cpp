@@ -0,0 +1,131 @@
+#include <chrono>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+#include "GFServer.h"
+
+/**
+ * Defines the field of the generated requests.
+ */
+const long LOAD_CHAR = 1000003;
+
+/**
+ * Defines the amount of bytes read at once.
+ */
+const size_t LOAD_BLOCK_SIZE = 1 << 16;
+
+/**
+ * Defines the request operations the generator picks from.
+ */
+const char *const LOAD_OPS[] = {"add", "sub", "mul", "mod", "factor"};
+
+/**
+ * Builds the pipelined requests of one client.
+ * @param seed The seed of the random numbers.
+ * @param requests The amount of requests.
+ * @return The requests, one per line.
+ */
+static std::string buildRequests(const unsigned int& seed, const long& requests)
+{
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<long> number(1, LOAD_CHAR - 1);
+    std::uniform_int_distribution<int> op(0, 4);
+    std::string field = " " + std::to_string(LOAD_CHAR) + " 1";
+    std::string text;
+    for (long i = 0; i < requests; i++)
+    {
+        int chosen = op(gen);
+        text += LOAD_OPS[chosen];
+        text += " " + std::to_string(number(gen)) + field;
+        if (chosen != 4)
+        {
+            text += " " + std::to_string(number(gen)) + field;
+        }
+        text += '\n';
+    }
+    return text;
+}
+
+/**
+ * Sends the requests of one client and counts its answers.
+ * @param path The path of the daemon socket.
+ * @param seed The seed of the random numbers.
+ * @param requests The amount of requests.
+ * @param answered Reference to the amount of answers that were received.
+ */
+static void runClient(const std::string path, const unsigned int seed, const long requests,
+                      long& answered)
+{
+    std::string text = buildRequests(seed, requests);
+    int fd = GFServer::connectTo(path);
+    if (fd < 0)
+    {
+        return;
+    }
+    std::thread sender([fd, &text]
+                       {
+                           size_t sent = 0;
+                           while (sent < text.size())
+                           {
+                               ssize_t done = send(fd, text.data() + sent, text.size() - sent,
+                                                   MSG_NOSIGNAL);
+                               if (done <= 0)
+                               {
+                                   break;
+                               }
+                               sent += done;
+                           }
+                           shutdown(fd, SHUT_WR);
+                       });
+    char buffer[LOAD_BLOCK_SIZE];
+    ssize_t got;
+    while ((got = read(fd, buffer, LOAD_BLOCK_SIZE)) > 0)
+    {
+        for (ssize_t i = 0; i < got; i++)
+        {
+            answered += (buffer[i] == '\n');
+        }
+    }
+    sender.join();
+    close(fd);
+}
+
+/**
+ * Runs the load generator - connects clients to the daemon, each sending random pipelined
+ * requests, and prints the throughput.
+ * usage: GFLoadGen <socket path> <clients> <requests per client>
+ * @return EXIT_FAILURE if the arguments are invalid or some answers are missing, EXIT_SUCCESS
+ * otherwise.
+ */
+int main(int argc, char *argv[])
+{
+    if (argc < 4)
+    {
+        std::cerr << "usage: GFLoadGen <socket path> <clients> <requests per client>" << std::endl;
+        return EXIT_FAILURE;
+    }
+    int clients = std::atoi(argv[2]);
+    long requests = std::atol(argv[3]);
+    std::vector<long> answered(clients, 0);
+    std::vector<std::thread> threads;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int i = 0; i < clients; i++)
+    {
+        threads.emplace_back(runClient, std::string(argv[1]), i + 1, requests,
+                             std::ref(answered[i]));
+    }
+    long total = 0;
+    for (int i = 0; i < clients; i++)
+    {
+        threads[i].join();
+        total += answered[i];
+    }
+    std::chrono::duration<double> took = std::chrono::steady_clock::now() - start;
+    std::cout << "answers=" << total << " seconds=" << took.count()
+              << " requests/s=" << total / took.count() << std::endl;
+    return (total == clients * requests) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,602 @@
+#include <algorithm>
+#include <cassert>
+#include <climits>
+#include <thread>
+#include "GFMatrix.h"
+
+/**
+ * Defines the size of the square tiles that products are calculated by.
+ */
+const long MATRIX_TILE = 64;
+
+/**
+ * Defines the amount of element operations from which the work is split between threads.
+ */
+const long PARALLEL_THRESHOLD = 1L << 18;
+
+/**
+ * Defines the amount of bits in a word of a GF(2) row.
+ */
+const long WORD_BITS = 64;
+
+/**
+ * Constructor of a zero matrix.
+ * @param f The GField of the elements.
+ * @param rows The amount of rows.
+ * @param cols The amount of columns.
+ */
+GFMatrix::GFMatrix(const GField& f, const long& rows, const long& cols) :
+        _f(f), _p(f.getChar()), _prime(f.getDegree() == 1), _binary(_prime && _p == 2),
+        _rows(rows), _cols(cols), _words((cols + WORD_BITS - 1) / WORD_BITS)
+{
+    assert(rows >= 0 && cols >= 0);
+    if (_binary)
+    {
+        _bits.assign(_rows * _words, 0);
+    }
+    else
+    {
+        _data.assign(_rows * _cols, 0);
+    }
+}
+
+/**
+ * @param f The GField of the elements.
+ * @param n The amount of rows and columns.
+ * @return The identity matrix of size n.
+ */
+GFMatrix GFMatrix::identity(const GField& f, const long& n)
+{
+    GFMatrix res(f, n, n);
+    for (long i = 0; i < n; i++)
+    {
+        res.setResidue(i, i, 1);
+    }
+    return res;
+}
+
+/**
+ * Adds two elements without overflowing, even when p is larger than 2**62.
+ * @param a The first field element.
+ * @param b The second field element.
+ * @return The sum of the elements.
+ */
+long GFMatrix::_add(const long& a, const long& b) const
+{
+    if (_prime)
+    {
+        return (a >= _p - b) ? a - (_p - b) : a + b;
+    }
+    return _f.addElements(a, b);
+}
+
+/**
+ * Subtracts two elements without overflowing, even when p is larger than 2**62.
+ * @param a The first field element.
+ * @param b The second field element.
+ * @return The difference of the elements.
+ */
+long GFMatrix::_sub(const long& a, const long& b) const
+{
+    if (_prime)
+    {
+        return (a >= b) ? a - b : a + (_p - b);
+    }
+    return _f.subtractElements(a, b);
+}
+
+/**
+ * @param a The first field element.
+ * @param b The second field element.
+ * @return The product of the elements.
+ */
+long GFMatrix::_mul(const long& a, const long& b) const
+{
+    if (_prime)
+    {
+        if (_p <= (1L << 32))
+        {
+            return (long) ((unsigned long) a * (unsigned long) b % (unsigned long) _p);
+        }
+        return (long) ((__int128) a * b % _p);
+    }
+    return _f.multiplyElements(a, b);
+}
+
+/**
+ * @param a A non zero field element.
+ * @return The inverse of the element.
+ */
+long GFMatrix::_inv(const long& a) const
+{
+    assert(a != 0);
+    if (_prime)
+    {
+        long res = 1, base = a;
+        for (long e = _p - 2; e > 0; e >>= 1)
+        {
+            if (e & 1)
+            {
+                res = _mul(res, base);
+            }
+            base = _mul(base, base);
+        }
+        return res;
+    }
+    return _f.inverseElement(a);
+}
+
+/**
+ * Runs the given function on parts of the given range, in parallel if the work is large enough.
+ * @param begin The first index of the range.
+ * @param end The index after the last one of the range.
+ * @param work The amount of element operations of the whole range.
+ * @param func The function, gets the first index and the index after the last one of its part.
+ */
+void GFMatrix::_parallelFor(const long& begin, const long& end, const long& work,
+                            const std::function<void(long, long)>& func)
+{
+    long threads = std::min((long) std::thread::hardware_concurrency(), end - begin);
+    if (work < PARALLEL_THRESHOLD || threads <= 1)
+    {
+        func(begin, end);
+        return;
+    }
+    std::vector<std::thread> workers;
+    long part = (end - begin + threads - 1) / threads;
+    for (long first = begin + part; first < end; first += part)
+    {
+        workers.emplace_back(func, first, std::min(first + part, end));
+    }
+    func(begin, std::min(begin + part, end));
+    for (std::thread& worker : workers)
+    {
+        worker.join();
+    }
+}
+
+/**
+ * Multiplies the given rows of this matrix by another one, tile by tile. Over GF(p) with
+ * p - 1 < 2**32 the products are summed in 64 bit accumulators, and reduced only once every
+ * as many products as the accumulators can hold.
+ * @param other The right matrix.
+ * @param res The product matrix.
+ * @param rowBegin The first row.
+ * @param rowEnd The row after the last one.
+ */
+void GFMatrix::_multiplyRows(const GFMatrix& other, GFMatrix& res, const long& rowBegin,
+                             const long& rowEnd) const
+{
+    if (_binary)
+    {
+        for (long i = rowBegin; i < rowEnd; i++)
+        {
+            uint64_t *out = &res._bits[i * res._words];
+            for (long k = 0; k < _cols; k++)
+            {
+                if ((_bits[i * _words + k / WORD_BITS] >> (k % WORD_BITS)) & 1)
+                {
+                    const uint64_t *row = &other._bits[k * other._words];
+                    for (long w = 0; w < other._words; w++)
+                    {
+                        out[w] ^= row[w];
+                    }
+                }
+            }
+        }
+        return;
+    }
+    long n = other._cols;
+    unsigned long top = _p - 1;
+    bool lazy = _prime && top < (1UL << 32);
+    long kTile = MATRIX_TILE;
+    if (lazy)
+    {
+        kTile = (long) std::min((ULONG_MAX - top) / (top * top), (unsigned long) MATRIX_TILE);
+    }
+    std::vector<unsigned long> acc(lazy ? (rowEnd - rowBegin) * n : 0, 0);
+    for (long i0 = rowBegin; i0 < rowEnd; i0 += MATRIX_TILE)
+    {
+        long iEnd = std::min(i0 + MATRIX_TILE, rowEnd);
+        for (long k0 = 0; k0 < _cols; k0 += kTile)
+        {
+            long kEnd = std::min(k0 + kTile, _cols);
+            for (long j0 = 0; j0 < n; j0 += MATRIX_TILE)
+            {
+                long jEnd = std::min(j0 + MATRIX_TILE, n);
+                for (long i = i0; i < iEnd; i++)
+                {
+                    for (long k = k0; k < kEnd; k++)
+                    {
+                        long a = _data[i * _cols + k];
+                        if (a == 0)
+                        {
+                            continue;
+                        }
+                        const long *row = &other._data[k * n];
+                        if (lazy)
+                        {
+                            unsigned long *out = &acc[(i - rowBegin) * n];
+                            for (long j = j0; j < jEnd; j++)
+                            {
+                                out[j] += (unsigned long) a * (unsigned long) row[j];
+                            }
+                        }
+                        else
+                        {
+                            long *out = &res._data[i * n];
+                            for (long j = j0; j < jEnd; j++)
+                            {
+                                out[j] = _add(out[j], _mul(a, row[j]));
+                            }
+                        }
+                    }
+                    if (lazy)
+                    {
+                        unsigned long *out = &acc[(i - rowBegin) * n];
+                        for (long j = j0; j < jEnd; j++)
+                        {
+                            out[j] %= (unsigned long) _p;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    for (size_t i = 0; i < acc.size(); i++)
+    {
+        res._data[rowBegin * n + i] = (long) acc[i];
+    }
+}
+
+/**
+ * Brings the matrix to reduced row echelon form by Gauss-Jordan elimination. The elimination of
+ * every pivot is split between threads by rows.
+ * @param pivotCols The amount of columns, from the first one, to look for pivots in.
+ * @param pivots Reference to the pivot column of every row of the rank.
+ * @return The rank of the first pivotCols columns.
+ */
+long GFMatrix::_reduce(const long& pivotCols, std::vector<long>& pivots)
+{
+    pivots.clear();
+    long rank = 0;
+    for (long c = 0; c < pivotCols && rank < _rows; c++)
+    {
+        long r = rank;
+        while (r < _rows && getResidue(r, c) == 0)
+        {
+            r++;
+        }
+        if (r == _rows)
+        {
+            continue;
+        }
+        if (_binary)
+        {
+            std::swap_ranges(_bits.begin() + r * _words, _bits.begin() + (r + 1) * _words,
+                             _bits.begin() + rank * _words);
+        }
+        else
+        {
+            std::swap_ranges(_data.begin() + r * _cols, _data.begin() + (r + 1) * _cols,
+                             _data.begin() + rank * _cols);
+            long inverse = _inv(_data[rank * _cols + c]);
+            for (long j = c; j < _cols; j++)
+            {
+                _data[rank * _cols + j] = _mul(_data[rank * _cols + j], inverse);
+            }
+        }
+        long pivot = rank;
+        _parallelFor(0, _rows, _rows * (_cols - c), [this, pivot, c](long begin, long end)
+        {
+            for (long i = begin; i < end; i++)
+            {
+                if (i == pivot)
+                {
+                    continue;
+                }
+                if (_binary)
+                {
+                    if ((_bits[i * _words + c / WORD_BITS] >> (c % WORD_BITS)) & 1)
+                    {
+                        for (long w = c / WORD_BITS; w < _words; w++)
+                        {
+                            _bits[i * _words + w] ^= _bits[pivot * _words + w];
+                        }
+                    }
+                    continue;
+                }
+                long factor = _data[i * _cols + c];
+                for (long j = c; factor != 0 && j < _cols; j++)
+                {
+                    _data[i * _cols + j] = _sub(_data[i * _cols + j],
+                                                _mul(factor, _data[pivot * _cols + j]));
+                }
+            }
+        });
+        pivots.push_back(c);
+        rank++;
+    }
+    return rank;
+}
+
+/**
+ * @param other A matrix with the same amount of rows.
+ * @return This matrix with the columns of the other one after its own.
+ */
+GFMatrix GFMatrix::_augment(const GFMatrix& other) const
+{
+    assert(_f == other._f && _rows == other._rows);
+    GFMatrix res(_f, _rows, _cols + other._cols);
+    for (long i = 0; i < _rows; i++)
+    {
+        for (long j = 0; j < _cols; j++)
+        {
+            res.setResidue(i, j, getResidue(i, j));
+        }
+        for (long j = 0; j < other._cols; j++)
+        {
+            res.setResidue(i, _cols + j, other.getResidue(i, j));
+        }
+    }
+    return res;
+}
+
+/**
+ * @return The GField of the elements.
+ */
+const GField& GFMatrix::getField() const
+{
+    return _f;
+}
+
+/**
+ * @return The amount of rows.
+ */
+const long& GFMatrix::getRows() const
+{
+    return _rows;
+}
+
+/**
+ * @return The amount of columns.
+ */
+const long& GFMatrix::getCols() const
+{
+    return _cols;
+}
+
+/**
+ * @param i The row.
+ * @param j The column.
+ * @return The residue of the element.
+ */
+long GFMatrix::getResidue(const long& i, const long& j) const
+{
+    assert(i >= 0 && i < _rows && j >= 0 && j < _cols);
+    if (_binary)
+    {
+        return (long) ((_bits[i * _words + j / WORD_BITS] >> (j % WORD_BITS)) & 1);
+    }
+    return _data[i * _cols + j];
+}
+
+/**
+ * @param i The row.
+ * @param j The column.
+ * @param k The residue to put in the element, modulo the order of the field.
+ */
+void GFMatrix::setResidue(const long& i, const long& j, const long& k)
+{
+    assert(i >= 0 && i < _rows && j >= 0 && j < _cols);
+    long order = _f.getOrder();
+    long residue = k % order;
+    residue = (residue < 0) ? residue + order : residue;
+    if (_binary)
+    {
+        uint64_t bit = (uint64_t) 1 << (j % WORD_BITS);
+        uint64_t& word = _bits[i * _words + j / WORD_BITS];
+        word = residue ? (word | bit) : (word & ~bit);
+        return;
+    }
+    _data[i * _cols + j] = residue;
+}
+
+/**
+ * @param i The row.
+ * @param j The column.
+ * @return The element as a GFNumber.
+ */
+GFNumber GFMatrix::get(const long& i, const long& j) const
+{
+    return _f.createNumber(getResidue(i, j));
+}
+
+/**
+ * @param i The row.
+ * @param j The column.
+ * @param num A GFNumber of the same field to put in the element.
+ */
+void GFMatrix::set(const long& i, const long& j, const GFNumber& num)
+{
+    assert(num.getField() == _f);
+    setResidue(i, j, num.getNumber());
+}
+
+/**
+ * @return The transposed matrix.
+ */
+GFMatrix GFMatrix::transpose() const
+{
+    GFMatrix res(_f, _cols, _rows);
+    for (long i = 0; i < _rows; i++)
+    {
+        for (long j = 0; j < _cols; j++)
+        {
+            res.setResidue(j, i, getResidue(i, j));
+        }
+    }
+    return res;
+}
+
+/**
+ * @return The rank of the matrix.
+ */
+long GFMatrix::rank() const
+{
+    GFMatrix copy(*this);
+    std::vector<long> pivots;
+    return copy._reduce(_cols, pivots);
+}
+
+/**
+ * Solves the linear system this * x = b. When there are many solutions, the free variables
+ * are zero.
+ * @param b A matrix with the same amount of rows, every column is a right hand side.
+ * @param x Reference to the solution.
+ * @return true if the system has a solution, false otherwise.
+ */
+bool GFMatrix::solve(const GFMatrix& b, GFMatrix& x) const
+{
+    GFMatrix m = _augment(b);
+    std::vector<long> pivots;
+    long rank = m._reduce(_cols, pivots);
+    for (long i = rank; i < _rows; i++)
+    {
+        for (long j = 0; j < b._cols; j++)
+        {
+            if (m.getResidue(i, _cols + j) != 0)
+            {
+                return false;
+            }
+        }
+    }
+    GFMatrix res(_f, _cols, b._cols);
+    for (long i = 0; i < rank; i++)
+    {
+        for (long j = 0; j < b._cols; j++)
+        {
+            res.setResidue(pivots[i], j, m.getResidue(i, _cols + j));
+        }
+    }
+    x = res;
+    return true;
+}
+
+/**
+ * @param res Reference to the inverse of this square matrix.
+ * @return true if the matrix is invertible, false otherwise.
+ */
+bool GFMatrix::inverse(GFMatrix& res) const
+{
+    assert(_rows == _cols);
+    GFMatrix m = _augment(identity(_f, _rows));
+    std::vector<long> pivots;
+    if (m._reduce(_cols, pivots) < _rows)
+    {
+        return false;
+    }
+    GFMatrix inv(_f, _rows, _cols);
+    for (long i = 0; i < _rows; i++)
+    {
+        for (long j = 0; j < _cols; j++)
+        {
+            inv.setResidue(i, j, m.getResidue(i, _cols + j));
+        }
+    }
+    res = inv;
+    return true;
+}
+
+/**
+ * @param other A matrix of the same field and size.
+ * @return The sum of the matrices.
+ */
+GFMatrix GFMatrix::operator+(const GFMatrix& other) const
+{
+    assert(_f == other._f && _rows == other._rows && _cols == other._cols);
+    GFMatrix res(*this);
+    for (size_t i = 0; i < _bits.size(); i++)
+    {
+        res._bits[i] ^= other._bits[i];
+    }
+    for (size_t i = 0; i < _data.size(); i++)
+    {
+        res._data[i] = _add(_data[i], other._data[i]);
+    }
+    return res;
+}
+
+/**
+ * @param other A matrix of the same field and size.
+ * @return The difference of the matrices.
+ */
+GFMatrix GFMatrix::operator-(const GFMatrix& other) const
+{
+    assert(_f == other._f && _rows == other._rows && _cols == other._cols);
+    GFMatrix res(*this);
+    for (size_t i = 0; i < _bits.size(); i++)
+    {
+        res._bits[i] ^= other._bits[i];
+    }
+    for (size_t i = 0; i < _data.size(); i++)
+    {
+        res._data[i] = _sub(_data[i], other._data[i]);
+    }
+    return res;
+}
+
+/**
+ * @param other A matrix of the same field, with as many rows as this one has columns.
+ * @return The product of the matrices.
+ */
+GFMatrix GFMatrix::operator*(const GFMatrix& other) const
+{
+    assert(_f == other._f && _cols == other._rows);
+    GFMatrix res(_f, _rows, other._cols);
+    _parallelFor(0, _rows, _rows * _cols * other._cols, [&](long begin, long end)
+    {
+        _multiplyRows(other, res, begin, end);
+    });
+    return res;
+}
+
+/**
+ * @param other Reference to another GFMatrix object.
+ * @return true if the fields, the sizes and the elements are equal, false otherwise.
+ */
+bool GFMatrix::operator==(const GFMatrix& other) const
+{
+    return _f == other._f && _rows == other._rows && _cols == other._cols &&
+           _data == other._data && _bits == other._bits;
+}
+
+/**
+ * @param other Reference to another GFMatrix object.
+ * @return true if the fields, the sizes or the elements are different, false otherwise.
+ */
+bool GFMatrix::operator!=(const GFMatrix& other) const
+{
+    return !(*this == other);
+}
+
+/**
+ * Prints the rows, separated by semicolons, and the field to the given stream.
+ * @param s Out stream to print to.
+ * @param obj Object to print.
+ * @return The given out stream.
+ */
+std::ostream& operator<<(std::ostream& s, const GFMatrix& obj)
+{
+    s << "[";
+    for (long i = 0; i < obj._rows; i++)
+    {
+        for (long j = 0; j < obj._cols; j++)
+        {
+            s << (j > 0 ? " " : "") << obj.getResidue(i, j);
+        }
+        s << (i + 1 < obj._rows ? "; " : "");
+    }
+    s << "] " << obj._f;
+    return s;
+}
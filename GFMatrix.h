@@ -0,0 +1,228 @@
+#ifndef EX1_GFMATRIX_H
+#define EX1_GFMATRIX_H
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "GFNumber.h"
+
+/**
+ * GFMatrix class, a matrix with elements in a GField - f.
+ * The elements are kept as one row-major array of residues, and for GF(2) as rows of packed bits.
+ * Products are calculated tile by tile with delayed reduction, and products, rank, solve and
+ * inverse split the rows between threads when the matrix is large enough.
+ */
+class GFMatrix
+{
+private:
+    GField _f;
+    long _p;
+    bool _prime, _binary;
+    long _rows, _cols, _words;
+    std::vector<long> _data;
+    std::vector<uint64_t> _bits;
+
+    /**
+     * Adds two elements without overflowing, even when p is larger than 2**62.
+     * @param a The first field element.
+     * @param b The second field element.
+     * @return The sum of the elements.
+     */
+    long _add(const long& a, const long& b) const;
+
+    /**
+     * Subtracts two elements without overflowing, even when p is larger than 2**62.
+     * @param a The first field element.
+     * @param b The second field element.
+     * @return The difference of the elements.
+     */
+    long _sub(const long& a, const long& b) const;
+
+    /**
+     * @param a The first field element.
+     * @param b The second field element.
+     * @return The product of the elements.
+     */
+    long _mul(const long& a, const long& b) const;
+
+    /**
+     * @param a A non zero field element.
+     * @return The inverse of the element.
+     */
+    long _inv(const long& a) const;
+
+    /**
+     * Runs the given function on parts of the given range, in parallel if the work is large enough.
+     * @param begin The first index of the range.
+     * @param end The index after the last one of the range.
+     * @param work The amount of element operations of the whole range.
+     * @param func The function, gets the first index and the index after the last one of its part.
+     */
+    static void _parallelFor(const long& begin, const long& end, const long& work,
+                             const std::function<void(long, long)>& func);
+
+    /**
+     * Multiplies the given rows of this matrix by another one, tile by tile.
+     * @param other The right matrix.
+     * @param res The product matrix.
+     * @param rowBegin The first row.
+     * @param rowEnd The row after the last one.
+     */
+    void _multiplyRows(const GFMatrix& other, GFMatrix& res, const long& rowBegin,
+                       const long& rowEnd) const;
+
+    /**
+     * Brings the matrix to reduced row echelon form by Gauss-Jordan elimination.
+     * @param pivotCols The amount of columns, from the first one, to look for pivots in.
+     * @param pivots Reference to the pivot column of every row of the rank.
+     * @return The rank of the first pivotCols columns.
+     */
+    long _reduce(const long& pivotCols, std::vector<long>& pivots);
+
+    /**
+     * @param other A matrix with the same amount of rows.
+     * @return This matrix with the columns of the other one after its own.
+     */
+    GFMatrix _augment(const GFMatrix& other) const;
+
+public:
+    /**
+     * Constructor of a zero matrix.
+     * @param f The GField of the elements.
+     * @param rows The amount of rows.
+     * @param cols The amount of columns.
+     */
+    GFMatrix(const GField& f, const long& rows, const long& cols);
+
+    /**
+     * @param f The GField of the elements.
+     * @param n The amount of rows and columns.
+     * @return The identity matrix of size n.
+     */
+    static GFMatrix identity(const GField& f, const long& n);
+
+    /**
+     * Copy constructor.
+     * @param other The object to copy from.
+     */
+    GFMatrix(const GFMatrix& other) = default;
+
+    /**
+     * Destructor for the GFMatrix object.
+     */
+    ~GFMatrix() = default;
+
+    /**
+     * @return The GField of the elements.
+     */
+    const GField& getField() const;
+
+    /**
+     * @return The amount of rows.
+     */
+    const long& getRows() const;
+
+    /**
+     * @return The amount of columns.
+     */
+    const long& getCols() const;
+
+    /**
+     * @param i The row.
+     * @param j The column.
+     * @return The residue of the element.
+     */
+    long getResidue(const long& i, const long& j) const;
+
+    /**
+     * @param i The row.
+     * @param j The column.
+     * @param k The residue to put in the element, modulo the order of the field.
+     */
+    void setResidue(const long& i, const long& j, const long& k);
+
+    /**
+     * @param i The row.
+     * @param j The column.
+     * @return The element as a GFNumber.
+     */
+    GFNumber get(const long& i, const long& j) const;
+
+    /**
+     * @param i The row.
+     * @param j The column.
+     * @param num A GFNumber of the same field to put in the element.
+     */
+    void set(const long& i, const long& j, const GFNumber& num);
+
+    /**
+     * @return The transposed matrix.
+     */
+    GFMatrix transpose() const;
+
+    /**
+     * @return The rank of the matrix.
+     */
+    long rank() const;
+
+    /**
+     * Solves the linear system this * x = b. When there are many solutions, the free variables
+     * are zero.
+     * @param b A matrix with the same amount of rows, every column is a right hand side.
+     * @param x Reference to the solution.
+     * @return true if the system has a solution, false otherwise.
+     */
+    bool solve(const GFMatrix& b, GFMatrix& x) const;
+
+    /**
+     * @param res Reference to the inverse of this square matrix.
+     * @return true if the matrix is invertible, false otherwise.
+     */
+    bool inverse(GFMatrix& res) const;
+
+    /**
+     * @param other Reference to another GFMatrix object.
+     * @return This object after putting in its data members the other's data members.
+     */
+    GFMatrix& operator=(const GFMatrix& other) = default;
+
+    /**
+     * @param other A matrix of the same field and size.
+     * @return The sum of the matrices.
+     */
+    GFMatrix operator+(const GFMatrix& other) const;
+
+    /**
+     * @param other A matrix of the same field and size.
+     * @return The difference of the matrices.
+     */
+    GFMatrix operator-(const GFMatrix& other) const;
+
+    /**
+     * @param other A matrix of the same field, with as many rows as this one has columns.
+     * @return The product of the matrices.
+     */
+    GFMatrix operator*(const GFMatrix& other) const;
+
+    /**
+     * @param other Reference to another GFMatrix object.
+     * @return true if the fields, the sizes and the elements are equal, false otherwise.
+     */
+    bool operator==(const GFMatrix& other) const;
+
+    /**
+     * @param other Reference to another GFMatrix object.
+     * @return true if the fields, the sizes or the elements are different, false otherwise.
+     */
+    bool operator!=(const GFMatrix& other) const;
+
+    /**
+     * Prints the rows, separated by semicolons, and the field to the given stream.
+     * @param s Out stream to print to.
+     * @param obj Object to print.
+     * @return The given out stream.
+     */
+    friend std::ostream& operator<<(std::ostream& s, const GFMatrix& obj);
+};
+
+#endif //EX1_GFMATRIX_H
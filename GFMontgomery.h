@@ -0,0 +1,173 @@
+#ifndef EX1_GFMONTGOMERY_H
+#define EX1_GFMONTGOMERY_H
+
+#include "GFUInt.h"
+
+/**
+ * GFMontgomery class, multiplication modulo an odd number n in Montgomery form - a residue a is
+ * kept as a * R modulo n, with R = 2**BITS of the backing integer, so a product is reduced by
+ * multiplications and shifts instead of a division.
+ * Int is the backing integer - unsigned long, unsigned __int128 or GFUInt.
+ */
+template <typename Int>
+class GFMontgomery
+{
+private:
+    Int _n, _nInverse, _one, _r2;
+
+    /**
+     * Reduces a product of two numbers in Montgomery form (REDC).
+     * @param lo The low half of the product.
+     * @param hi The high half of the product, smaller than n.
+     * @return The product times R**(-1) modulo n.
+     */
+    Int _reduce(const Int& lo, const Int& hi) const
+    {
+        Int m = lo * _nInverse;
+        Int mLo, mHi;
+        GFWideTraits<Int>::multiplyWide(m, _n, mLo, mHi);
+        Int carry = (lo != Int(0)) ? Int(1) : Int(0);
+        Int res = hi + mHi;
+        bool overflow = res < hi;
+        res += carry;
+        overflow = overflow || res < carry;
+        if (overflow || res >= _n)
+        {
+            res -= _n;
+        }
+        return res;
+    }
+
+public:
+    /**
+     * Default constructor, of the modulo 1 - it can't multiply, and only keeps the place of a
+     * Montgomery form that isn't needed.
+     */
+    GFMontgomery() : _n(1), _nInverse(0), _one(0), _r2(0)
+    {}
+
+    /**
+     * Constructor that finds the constants of the given modulo - -n**(-1) modulo R by Newton
+     * iteration, and R and R**2 modulo n by doubling.
+     * @param n The odd modulo, bigger than 1.
+     */
+    explicit GFMontgomery(const Int& n) : _n(n)
+    {
+        assert((n & Int(1)) == Int(1) && n > Int(1));
+        Int inverse = n;
+        for (int bits = 3; bits < GFWideTraits<Int>::BITS; bits *= 2)
+        {
+            inverse *= Int(2) - n * inverse;
+        }
+        _nInverse = Int(0) - inverse;
+        _one = (Int(0) - n) % n;
+        _r2 = _one;
+        for (int i = 0; i < GFWideTraits<Int>::BITS; i++)
+        {
+            _r2 = add(_r2, _r2);
+        }
+    }
+
+    /**
+     * @return The modulo.
+     */
+    const Int& getModulus() const
+    {
+        return _n;
+    }
+
+    /**
+     * @return 1 in Montgomery form.
+     */
+    const Int& one() const
+    {
+        return _one;
+    }
+
+    /**
+     * @param a A residue.
+     * @return The residue in Montgomery form.
+     */
+    Int toMontgomery(const Int& a) const
+    {
+        return multiply(a % _n, _r2);
+    }
+
+    /**
+     * @param a A residue in Montgomery form.
+     * @return The residue.
+     */
+    Int fromMontgomery(const Int& a) const
+    {
+        return _reduce(a, Int(0));
+    }
+
+    /**
+     * @param a The first residue, smaller than n.
+     * @param b The second residue, smaller than n.
+     * @return The sum modulo n.
+     */
+    Int add(const Int& a, const Int& b) const
+    {
+        Int res = a + b;
+        if (res < a || res >= _n)
+        {
+            res -= _n;
+        }
+        return res;
+    }
+
+    /**
+     * @param a The first residue, smaller than n.
+     * @param b The second residue, smaller than n.
+     * @return The difference modulo n.
+     */
+    Int subtract(const Int& a, const Int& b) const
+    {
+        return (a >= b) ? a - b : a + (_n - b);
+    }
+
+    /**
+     * @param a The first residue in Montgomery form.
+     * @param b The second residue in Montgomery form.
+     * @return The product in Montgomery form.
+     */
+    Int multiply(const Int& a, const Int& b) const
+    {
+        Int lo, hi;
+        GFWideTraits<Int>::multiplyWide(a, b, lo, hi);
+        return _reduce(lo, hi);
+    }
+
+    /**
+     * @param a The first residue, smaller than n.
+     * @param b The second residue, smaller than n.
+     * @return The product modulo n, of residues that aren't in Montgomery form.
+     */
+    Int multiplyPlain(const Int& a, const Int& b) const
+    {
+        return multiply(multiply(a, b), _r2);
+    }
+
+    /**
+     * @param a A residue in Montgomery form.
+     * @param e The exponent.
+     * @return a to the power of e, in Montgomery form.
+     */
+    Int power(Int a, Int e) const
+    {
+        Int res = _one;
+        while (e != Int(0))
+        {
+            if ((e & Int(1)) == Int(1))
+            {
+                res = multiply(res, a);
+            }
+            a = multiply(a, a);
+            e >>= 1;
+        }
+        return res;
+    }
+};
+
+#endif //EX1_GFMONTGOMERY_H
@@ -1,6 +1,13 @@
 #include "GFNumber.h"
+#include "GFSmooth.h"
+#include "GFStats.h"
+#include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <new>
 #include <random>
+#include <thread>
+#include <vector>
 
 /**
  * Define the default n value.
@@ -12,6 +19,200 @@ const long DEFAULT_N = 0;
  */
 const int SMALLEST_ODD_PRIME = 3;
 
+/**
+ * Defines the amount of random starting points Pollard Rho algorithm tries before it gives up.
+ */
+const int POLLARD_RHO_ATTEMPTS = 8;
+
+/**
+ * Defines the largest amount of prime factors of a GFNumber (n < 2**63), the size of the factors
+ * array that is kept in an arena.
+ */
+const int MAX_PRIME_FACTORS = 63;
+
+/**
+ * Defines the largest amount of baby steps, so their hash table (twice as many slots) fits in the
+ * L2 cache.
+ */
+const long BSGS_MAX_BABY_STEPS = 1L << 15;
+
+/**
+ * Defines the smallest prime subgroup order that is solved by Pollard's kangaroo algorithm
+ * instead of baby-step giant-step.
+ */
+const long KANGAROO_MIN_ORDER = 1L << 34;
+
+/**
+ * Defines the amount of jump functions Pollard's kangaroo algorithm tries before it gives up.
+ */
+const int KANGAROO_ATTEMPTS = 8;
+
+/**
+ * Defines the smallest prime subgroup order that gets its own thread in the discrete logarithm.
+ */
+const long PARALLEL_SUBGROUP_ORDER = 1L << 20;
+
+/**
+ * Defines the multiplier of the hash functions of the discrete logarithm (2**64 / golden ratio).
+ */
+const unsigned long HASH_MULTIPLIER = 0x9E3779B97F4A7C15UL;
+
+/**
+ * Finds the inverse of a modulo m by the extended Euclidean algorithm.
+ * @param a A number coprime to m.
+ * @param m The modulo.
+ * @return The inverse of a modulo m, in [0, m).
+ */
+static long inverseModulo(long a, const long& m)
+{
+    long oldR = a % m, r = m, oldS = 1, s = 0;
+    while (r != 0)
+    {
+        long quotient = oldR / r;
+        long temp = oldR - quotient * r;
+        oldR = r;
+        r = temp;
+        temp = oldS - quotient * s;
+        oldS = s;
+        s = temp;
+    }
+    return ((oldS % m) + m) % m;
+}
+
+/**
+ * @param a The first number, in [0, m).
+ * @param b The second number, in [0, m).
+ * @param m The modulo.
+ * @return a * b modulo m, without overflowing.
+ */
+static inline long multiplyModulo(const long& a, const long& b, const long& m)
+{
+    return (long) ((__int128) a * b % m);
+}
+
+/**
+ * @param a The first number, in [0, m).
+ * @param b The second number, in [0, m).
+ * @param m The modulo.
+ * @return a - b modulo m, without overflowing.
+ */
+static inline long subtractModulo(const long& a, const long& b, const long& m)
+{
+    return (a >= b) ? a - b : a - b + m;
+}
+
+/**
+ * @param a The base, in [0, m).
+ * @param e The non negative exponent.
+ * @param m The modulo.
+ * @return a to the power of e modulo m.
+ */
+static long powerModulo(long a, long e, const long& m)
+{
+    long res = 1 % m;
+    for (; e > 0; e >>= 1)
+    {
+        if (e & 1)
+        {
+            res = multiplyModulo(res, a, m);
+        }
+        a = multiplyModulo(a, a, m);
+    }
+    return res;
+}
+
+/**
+ * Finds a square root modulo an odd prime by the Tonelli-Shanks algorithm - p - 1 = q * 2**s,
+ * and the root of a**q is fixed in the 2**s subgroup with the powers of a non residue.
+ * @param a A number in [1, p).
+ * @param p The odd prime.
+ * @return A root of a modulo p, or -1 if a is not a square.
+ */
+static long tonelliShanks(const long& a, const long& p)
+{
+    if (powerModulo(a, (p - 1) / 2, p) != 1)
+    {
+        return -1;
+    }
+    long q = p - 1, s = 0;
+    while (q % 2 == 0)
+    {
+        q /= 2;
+        s++;
+    }
+    long z = 2;
+    while (powerModulo(z, (p - 1) / 2, p) == 1)
+    {
+        z++;
+    }
+    long c = powerModulo(z, q, p), t = powerModulo(a, q, p), root = powerModulo(a, (q + 1) / 2, p);
+    while (t != 1)
+    {
+        long i = 0;
+        for (long square = t; square != 1; square = multiplyModulo(square, square, p))
+        {
+            i++;
+        }
+        long b = c;
+        for (long j = 0; j < s - i - 1; j++)
+        {
+            b = multiplyModulo(b, b, p);
+        }
+        s = i;
+        c = multiplyModulo(b, b, p);
+        t = multiplyModulo(t, c, p);
+        root = multiplyModulo(root, b, p);
+    }
+    return root;
+}
+
+/**
+ * Finds a square root of a unit modulo p**k. For an odd p, the root modulo p is lifted together
+ * with the inverse of its double, so every step doubles the precision of both. For p = 2 the
+ * derivative 2r is never a unit, so the root is lifted one bit at a time.
+ * @param u A number in [0, p**k), not divisible by p.
+ * @param p The prime.
+ * @param k The positive exponent.
+ * @param pk p**k.
+ * @return A root of u modulo p**k, or -1 if u is not a square.
+ */
+static long sqrtUnit(const long& u, const long& p, const long& k, const long& pk)
+{
+    if (p == 2)
+    {
+        if (k >= 2 && u % ((k == 2) ? 4 : 8) != 1)
+        {
+            return -1;
+        }
+        long root = 1;
+        for (long j = 3; j < k; j++)
+        {
+            long next = 1L << (j + 1);
+            if ((multiplyModulo(root, root, next) - u % next) % next != 0)
+            {
+                root += 1L << (j - 1);
+            }
+        }
+        return root % pk;
+    }
+    long root = tonelliShanks(u % p, p);
+    if (root < 0)
+    {
+        return -1;
+    }
+    long inverse = inverseModulo(multiplyModulo(2, root, p), p);
+    for (long e = 1, pe = p; e < k;)
+    {
+        pe = (2 * e >= k) ? pk : pe * pe;
+        e = std::min(2 * e, k);
+        long error = subtractModulo(multiplyModulo(root, root, pe), u % pe, pe);
+        root = subtractModulo(root, multiplyModulo(error, inverse, pe), pe);
+        long product = multiplyModulo(multiplyModulo(2, root, pe), inverse, pe);
+        inverse = multiplyModulo(inverse, subtractModulo(2, product, pe), pe);
+    }
+    return root;
+}
+
 
 /**
  * Two arguments constructor.
@@ -39,15 +240,50 @@ GFNumber::GFNumber(const GFNumber& other) : _f(other.getField()), _n(other.getNu
 
 /**
  * Calculates the correct n that needs to be saved in the GFNumber, by getting the original n.
+ * The result is always in [0, order), also for negative multiples of the order, since the tables
+ * of the field are indexed by it.
  */
 long GFNumber::_modulo(const long& n) const
 {
     long order = _f.getOrder();
-    if (n >= 0)
+    long res = n % order;
+    return (res < 0) ? res + order : res;
+}
+
+/**
+ * Adds the given long to n without overflowing - n and i may both be close to 2**63.
+ * @param i The long to add.
+ * @return The sum modulo the order, it may be negative when i is.
+ */
+long GFNumber::_add(const long& i) const
+{
+    return (long) (((__int128) _n + i) % _f.getOrder());
+}
+
+/**
+ * Subtracts the given long from n without overflowing.
+ * @param i The long to subtract.
+ * @return The difference modulo the order, it may be negative.
+ */
+long GFNumber::_subtract(const long& i) const
+{
+    return (long) (((__int128) _n - i) % _f.getOrder());
+}
+
+/**
+ * Multiplies n by the given long without overflowing - a residue is multiplied by the field, by
+ * one table lookup when the field has tables.
+ * @param i The long to multiply by.
+ * @return The product modulo the order, it may be negative when i is.
+ */
+long GFNumber::_multiply(const long& i) const
+{
+    long order = _f.getOrder();
+    if (i >= 0 && i < order)
     {
-        return n % order;
+        return _f.multiplyResidues(_n, i);
     }
-    return order + n % order;
+    return (long) ((__int128) _n * i % order);
 }
 
 /**
@@ -72,8 +308,7 @@ const GField& GFNumber::getField() const
  */
 GFNumber GFNumber::_pollardRhoFunction(const long& modulo) const
 {
-    long res = _n * _n + 1;
-    return _f.createNumber(res % modulo);
+    return _f.createNumber((long) (((__int128) _n * _n + 1) % modulo));
 }
 
 /**
@@ -84,26 +319,32 @@ GFNumber GFNumber::_pollardRhoFunction(const long& modulo) const
  */
 bool GFNumber::_pollardRho(GFNumber& res) const
 {
+    GF_STATS_TIME(POLLARD_RHO);
     std::random_device rand;
     std::mt19937 gen(rand());
-    std::uniform_int_distribution<> random(1, _n - 1);
-    GFNumber x = _f.createNumber(random(gen));
-    GFNumber y = x;
-    GFNumber p = _f.createNumber(1);
-    GFNumber temp;
-    while (p.getNumber() == 1)
+    std::uniform_int_distribution<long> random(1, _n - 1);
+    for (int attempt = 0; attempt < POLLARD_RHO_ATTEMPTS; attempt++)
     {
-        x = x._pollardRhoFunction(_n);
-        y = y._pollardRhoFunction(_n)._pollardRhoFunction(_n);
-        temp = (x > y) ? (x - y) : (y - x);
-        p = _f.gcd(temp, *this);
-    }
-    if (p == *this)
-    {
-        return false;
+        GF_STATS_COUNT(RHO_RESTARTS, attempt > 0);
+        GFNumber x = _f.createNumber(random(gen));
+        GFNumber y = x;
+        GFNumber p = _f.createNumber(1);
+        GFNumber temp;
+        while (p.getNumber() == 1)
+        {
+            GF_STATS_COUNT(RHO_ITERATIONS, 1);
+            x = x._pollardRhoFunction(_n);
+            y = y._pollardRhoFunction(_n)._pollardRhoFunction(_n);
+            temp = (x > y) ? (x - y) : (y - x);
+            p = _f.gcd(temp, *this);
+        }
+        if (p != *this)
+        {
+            res = p;
+            return true;
+        }
     }
-    res = p;
-    return true;
+    return false;
 }
 
 /**
@@ -115,6 +356,7 @@ bool GFNumber::_pollardRho(GFNumber& res) const
  */
 void GFNumber::_resizeArr(GFNumber*& arr, const int& curSize)
 {
+    GF_STATS_COUNT(ARRAY_RESIZES, 1);
     GFNumber *temp = arr;
     int newSize = (curSize == 0) ? 1 : curSize * 2;
     arr = new GFNumber[newSize];
@@ -138,7 +380,7 @@ void GFNumber::_addToArr(GFNumber*& arr, int& counter, int* arrLength)
         _resizeArr(arr, *arrLength);
         *arrLength = (*arrLength == 0) ? 1 : *arrLength * 2;
     }
-    arr[counter++] = *this;
+    new (&arr[counter++]) GFNumber(*this);
 }
 
 /**
@@ -150,10 +392,12 @@ void GFNumber::_addToArr(GFNumber*& arr, int& counter, int* arrLength)
  */
 void GFNumber::_trialDivision(GFNumber*& result, int& counter, int *arrLength)
 {
+    GF_STATS_TIME(TRIAL_DIVISION);
     GFNumber zeroGFN = _f.createNumber(0);
     long i = SMALLEST_ODD_PRIME;
     while (i * i <= _n)
     {
+        GF_STATS_COUNT(TRIAL_CANDIDATES, 1);
         if (*this % i == zeroGFN)
         {
             GFNumber tempGFN = _f.createNumber(i);
@@ -168,19 +412,17 @@ void GFNumber::_trialDivision(GFNumber*& result, int& counter, int *arrLength)
 }
 
 /**
- * Finds all the prime factors of this GFNumber and save them in a dynamic allocated array, it
- * will save the factors amount in the given arrLength pointer.
- * @param arrLength The array length pointer.
- * @return The array of the prime factors, if n is prime - the array will be empty.
+ * Finds all the prime factors of this GFNumber, and add them to the given result array.
+ * @param result The array that will contain all the prime factors.
+ * @param counter The current number of GFNumber objects in the array.
+ * @param arrLength The current array capacity.
  */
-GFNumber *GFNumber::getPrimeFactors(int* arrLength) const
+void GFNumber::_factor(GFNumber*& result, int& counter, int *arrLength) const
 {
-    *arrLength = 0;
-    int counter = 0;
-    GFNumber *result = new GFNumber[*arrLength];
+    GF_STATS_TIME(FACTORIZATION);
     if (_n == 0 || _n == 1 || getIsPrime())
     {
-        return result;
+        return;
     }
     GFNumber num = *this;
     const GFNumber zeroGFN = _f.createNumber(0);
@@ -197,15 +439,15 @@ GFNumber *GFNumber::getPrimeFactors(int* arrLength) const
         {
             break;
         }
-        if (tempGFN.getIsPrime())
+        num._n = num._n / tempGFN._n;
+        if (!tempGFN.getIsPrime())
         {
-            tempGFN._addToArr(result, counter, arrLength);
+            tempGFN._trialDivision(result, counter, arrLength);
         }
-        else
+        if (tempGFN._n > 1)
         {
-            tempGFN._trialDivision(result, counter, arrLength);
+            tempGFN._addToArr(result, counter, arrLength);
         }
-        num._n = num._n / tempGFN._n;
     }
     if (!num.getIsPrime())
     {
@@ -215,6 +457,39 @@ GFNumber *GFNumber::getPrimeFactors(int* arrLength) const
     {
         num._addToArr(result, counter, arrLength);
     }
+}
+
+/**
+ * Finds all the prime factors of this GFNumber and save them in a dynamic allocated array, it
+ * will save the factors amount in the given arrLength pointer.
+ * @param arrLength The array length pointer.
+ * @return The array of the prime factors, if n is prime - the array will be empty.
+ */
+GFNumber *GFNumber::getPrimeFactors(int* arrLength) const
+{
+    *arrLength = 0;
+    int counter = 0;
+    GFNumber *result = new GFNumber[*arrLength];
+    _factor(result, counter, arrLength);
+    *arrLength = counter;
+    return result;
+}
+
+/**
+ * Finds all the prime factors of this GFNumber like getPrimeFactors, but keeps the array in the
+ * given arena instead of the heap. The array has room for the most factors a GFNumber can have,
+ * so it's never resized.
+ * @param arrLength The array length pointer.
+ * @param arena The arena to keep the array in.
+ * @return The array of the prime factors, if n is prime - the array will be empty.
+ */
+GFNumber *GFNumber::getPrimeFactors(int* arrLength, GFArena& arena) const
+{
+    *arrLength = MAX_PRIME_FACTORS;
+    int counter = 0;
+    GFNumber *result = arena.allocate<GFNumber>(MAX_PRIME_FACTORS);
+    _factor(result, counter, arrLength);
+    assert(*arrLength == MAX_PRIME_FACTORS);
     *arrLength = counter;
     return result;
 }
@@ -225,7 +500,9 @@ GFNumber *GFNumber::getPrimeFactors(int* arrLength) const
 void GFNumber::printFactors() const
 {
     int arrLength = 0;
-    GFNumber* primeFactors = getPrimeFactors(&arrLength);
+    GFArena& arena = GFArena::local();
+    GFArena::Mark mark = arena.getMark();
+    GFNumber* primeFactors = getPrimeFactors(&arrLength, arena);
     std::cout << _n << "=";
     if (arrLength == 0)
     {
@@ -239,7 +516,7 @@ void GFNumber::printFactors() const
         }
         std::cout << primeFactors[arrLength - 1]._n << std::endl;
     }
-    delete[] primeFactors;
+    arena.rewind(mark);
 }
 
 /**
@@ -251,6 +528,373 @@ bool GFNumber::getIsPrime() const
     return (GField::isPrime(_n));
 }
 
+/**
+ * Finds the discrete logarithm in a subgroup of prime order by baby-step giant-step - g**j for
+ * j < m are kept in an open addressing hash table, and h * g**(-m*i) is looked up in it.
+ * @param f The field.
+ * @param g The generator of the subgroup.
+ * @param h An element of the subgroup.
+ * @param q The prime order of g.
+ * @return x in [0, q) with g**x = h, or -1 if there is none.
+ */
+long GFNumber::_babyStepGiantStep(const GField& f, const long& g, const long& h, const long& q)
+{
+    long m = std::min((long) std::ceil(std::sqrt((double) q)), BSGS_MAX_BABY_STEPS);
+    int bits = 1;
+    while ((1L << bits) < 2 * m)
+    {
+        bits++;
+    }
+    const long EMPTY = -1;
+    std::vector<std::pair<long, long>> table(1L << bits, std::make_pair(EMPTY, 0L));
+    auto slot = [bits](const long& key)
+    {
+        return (size_t) (((unsigned long) key * HASH_MULTIPLIER) >> (64 - bits));
+    };
+    long cur = 1;
+    for (long j = 0; j < m; j++)
+    {
+        size_t i = slot(cur);
+        while (table[i].first != EMPTY && table[i].first != cur)
+        {
+            i = (i + 1) & (table.size() - 1);
+        }
+        if (table[i].first == EMPTY)
+        {
+            table[i] = std::make_pair(cur, j);
+        }
+        cur = f.multiplyElements(cur, g);
+    }
+    long giant = f.inverseElement(cur);
+    long gamma = h;
+    for (long i = 0; i * m < q; i++)
+    {
+        for (size_t k = slot(gamma); table[k].first != EMPTY; k = (k + 1) & (table.size() - 1))
+        {
+            if (table[k].first == gamma)
+            {
+                return (i * m + table[k].second) % q;
+            }
+        }
+        gamma = f.multiplyElements(gamma, giant);
+    }
+    return -1;
+}
+
+/**
+ * Finds the discrete logarithm in a subgroup of prime order by Pollard's kangaroo algorithm - a
+ * tame kangaroo starts at g**(q-1) and a wild one at h, both jump by powers of two of g chosen by
+ * a hash of their position, and when the wild one lands on the tame one's trap the logarithm is
+ * the difference of their distances.
+ * @param f The field.
+ * @param g The generator of the subgroup.
+ * @param h An element of the subgroup.
+ * @param q The prime order of g.
+ * @return x in [0, q) with g**x = h, or -1 if the kangaroos didn't meet.
+ */
+long GFNumber::_kangaroo(const GField& f, const long& g, const long& h, const long& q)
+{
+    double root = std::sqrt((double) q);
+    int k = 1;
+    while (k < 62 && (double) ((1L << (k + 1)) - 1) / (k + 1) <= root / 2)
+    {
+        k++;
+    }
+    std::vector<long> jumps(k);
+    jumps[0] = g;
+    for (int j = 1; j < k; j++)
+    {
+        jumps[j] = f.multiplyElements(jumps[j - 1], jumps[j - 1]);
+    }
+    long tameSteps = 2 * (long) root + 1;
+    for (int attempt = 0; attempt < KANGAROO_ATTEMPTS; attempt++)
+    {
+        auto jump = [attempt, k](const long& w)
+        {
+            return (int) ((((unsigned long) w + attempt) * HASH_MULTIPLIER >> 32) % k);
+        };
+        long tame = f.powerElement(g, q - 1), tameDist = 0;
+        for (long i = 0; i < tameSteps; i++)
+        {
+            int j = jump(tame);
+            tame = f.multiplyElements(tame, jumps[j]);
+            tameDist += 1L << j;
+        }
+        long wild = h, wildDist = 0;
+        while (wildDist <= q - 1 + tameDist)
+        {
+            if (wild == tame)
+            {
+                return (q - 1 + tameDist - wildDist) % q;
+            }
+            int j = jump(wild);
+            wild = f.multiplyElements(wild, jumps[j]);
+            wildDist += 1L << j;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Finds the discrete logarithm in a subgroup of prime power order, digit by digit in base q -
+ * every digit is a logarithm in the subgroup of order q.
+ * @param f The field.
+ * @param g An element whose order is a power of q.
+ * @param h Another element whose order is a power of q.
+ * @param q The prime.
+ * @param e The largest power of q that the order of g can be.
+ * @param modulus Reference to the order of g.
+ * @return x in [0, modulus) with g**x = h, or -1 if there is none.
+ */
+long GFNumber::_primePowerLog(const GField& f, const long& g, const long& h, const long& q,
+                              const int& e, long& modulus)
+{
+    int order = 0;
+    modulus = 1;
+    for (long cur = g; cur != 1 && order < e; order++)
+    {
+        cur = f.powerElement(cur, q);
+        modulus *= q;
+    }
+    if (f.powerElement(h, modulus) != 1)
+    {
+        return -1;
+    }
+    if (order == 0)
+    {
+        return 0;
+    }
+    long gamma = f.powerElement(g, modulus / q);
+    long gInverse = f.inverseElement(g);
+    long x = 0;
+    for (long k = 0, qk = 1; k < order; k++, qk *= q)
+    {
+        long hk = f.multiplyElements(f.powerElement(gInverse, x), h);
+        hk = f.powerElement(hk, modulus / qk / q);
+        long digit = -1;
+        if (q >= KANGAROO_MIN_ORDER)
+        {
+            digit = _kangaroo(f, gamma, hk, q);
+        }
+        if (digit < 0)
+        {
+            digit = _babyStepGiantStep(f, gamma, hk, q);
+        }
+        if (digit < 0)
+        {
+            return -1;
+        }
+        x += digit * qk;
+    }
+    return x;
+}
+
+/**
+ * Finds the discrete logarithm of this GFNumber to the given base, in the multiplicative group
+ * of the field (of the extension field when l > 1). With the cached factorization of the group
+ * order, the logarithm is found in every prime power subgroup by Pohlig-Hellman and joined by
+ * the CRT. Large subgroups are solved in parallel.
+ * @param base A non zero GFNumber of the same field.
+ * @return The smallest x >= 0 with base**x = n, or -1 if there is none.
+ */
+long GFNumber::discreteLog(const GFNumber& base) const
+{
+    assert(_f == base.getField());
+    assert(base.getNumber() != 0);
+    if (_n == 0)
+    {
+        return -1;
+    }
+    long groupOrder = _f.getOrder() - 1;
+    const std::vector<std::pair<long, int>>& powers = _f.getGroupFactors();
+    std::vector<long> logs(powers.size()), moduli(powers.size());
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < powers.size(); i++)
+    {
+        long primePower = 1;
+        for (int j = 0; j < powers[i].second; j++)
+        {
+            primePower *= powers[i].first;
+        }
+        long cofactor = groupOrder / primePower;
+        auto solve = [this, &base, &powers, &logs, &moduli, i, cofactor]()
+        {
+            logs[i] = _primePowerLog(_f, _f.powerElement(base._n, cofactor),
+                                     _f.powerElement(_n, cofactor), powers[i].first,
+                                     powers[i].second, moduli[i]);
+        };
+        if (powers[i].first >= PARALLEL_SUBGROUP_ORDER)
+        {
+            workers.emplace_back(solve);
+        }
+        else
+        {
+            solve();
+        }
+    }
+    for (std::thread& worker : workers)
+    {
+        worker.join();
+    }
+    long x = 0, modulus = 1;
+    for (size_t i = 0; i < powers.size(); i++)
+    {
+        if (logs[i] < 0)
+        {
+            return -1;
+        }
+        long diff = ((logs[i] - x) % moduli[i] + moduli[i]) % moduli[i];
+        long t = (long) ((__int128) diff * inverseModulo(modulus % moduli[i], moduli[i]) %
+                         moduli[i]);
+        x += modulus * t;
+        modulus *= moduli[i];
+    }
+    return x;
+}
+
+/**
+ * Finds the multiplicative order of this GFNumber in the field (in the extension field when
+ * l > 1), with the cached factorization of the group order.
+ * @return The smallest k > 0 with n**k = 1, n must not be 0.
+ */
+long GFNumber::multiplicativeOrder() const
+{
+    long order = 0;
+    _f.multiplicativeOrders(this, 1, &order);
+    return order;
+}
+
+/**
+ * Adds the given GFNumber as an element of the extension field GF(p**l) - the base p digits of
+ * n are the coefficients of a polynomial over GF(p). Unlike operator+, no carries pass between
+ * the coefficients.
+ * @param other The object to add to this GFNumber.
+ * @return The sum of the elements.
+ */
+GFNumber GFNumber::fieldAdd(const GFNumber& other) const
+{
+    assert(_f == other.getField());
+    return _f.createNumber(_f.addElements(_n, other.getNumber()));
+}
+
+/**
+ * Subtracts the given GFNumber as an element of the extension field.
+ * @param other The object to subtract from this GFNumber.
+ * @return The difference of the elements.
+ */
+GFNumber GFNumber::fieldSubtract(const GFNumber& other) const
+{
+    assert(_f == other.getField());
+    return _f.createNumber(_f.subtractElements(_n, other.getNumber()));
+}
+
+/**
+ * Multiplies by the given GFNumber as an element of the extension field - the product of the
+ * polynomials modulo the irreducible polynomial of the field.
+ * @param other The object to multiply this GFNumber by.
+ * @return The product of the elements.
+ */
+GFNumber GFNumber::fieldMultiply(const GFNumber& other) const
+{
+    assert(_f == other.getField());
+    return _f.createNumber(_f.multiplyElements(_n, other.getNumber()));
+}
+
+/**
+ * Finds the inverse of this GFNumber as an element of the extension field.
+ * @return The multiplicative inverse, n must not be 0.
+ */
+GFNumber GFNumber::fieldInverse() const
+{
+    assert(_n != 0);
+    return _f.createNumber(_f.inverseElement(_n));
+}
+
+/**
+ * Finds the B-smooth part of n by Bernstein's method (GFSmooth) - the product of the primes up to
+ * B is reduced modulo n, and the primes that divide the remainder are the small factors of n.
+ * @param bound The bound B.
+ * @return The smooth part, in the field of this GFNumber (0 if n is 0).
+ */
+GFNumber GFNumber::smoothPart(const long& bound) const
+{
+    return _f.createNumber(GFSmooth::smoothPart(_n, bound));
+}
+
+/**
+ * @param bound The bound B.
+ * @return true if n is positive and all its prime factors are at most B, false otherwise.
+ */
+bool GFNumber::isSmooth(const long& bound) const
+{
+    return _n > 0 && GFSmooth::smoothPart(_n, bound) == _n;
+}
+
+/**
+ * Finds the inverse of this GFNumber modulo p**l - the inverse modulo p is found by the extended
+ * Euclidean algorithm, and x = x * (2 - n * x) doubles the precision of x every step, from p**e to
+ * p**(2e), so only O(log l) products are needed. A field with tables looks the inverse up instead.
+ * @return The multiplicative inverse, n must not be divisible by p.
+ */
+GFNumber GFNumber::inverse() const
+{
+    const long& p = _f.getChar();
+    const long& l = _f.getDegree();
+    assert(_n % p != 0);
+    if (_f.hasInverseTables())
+    {
+        return _f.createNumber(_f.inverseResidue(_n));
+    }
+    long x = inverseModulo(_n % p, p);
+    for (long e = 1, pe = p; e < l;)
+    {
+        pe = (2 * e >= l) ? _f.getOrder() : pe * pe;
+        e = std::min(2 * e, l);
+        x = multiplyModulo(x, subtractModulo(2, multiplyModulo(_n % pe, x, pe), pe), pe);
+    }
+    return _f.createNumber(x);
+}
+
+/**
+ * Finds a square root of this GFNumber modulo p**l - n = p**v * u with u a unit, v must be even,
+ * and the root is p**(v / 2) times the root of u modulo p**(l - v), found modulo p and lifted.
+ * @param res Reference to the square root.
+ * @return true if n is a square modulo p**l, false otherwise.
+ */
+bool GFNumber::sqrt(GFNumber& res) const
+{
+    const long& p = _f.getChar();
+    if (_n == 0)
+    {
+        res = _f.createNumber(0);
+        return true;
+    }
+    long u = _n, v = 0, pv = 1;
+    while (u % p == 0)
+    {
+        u /= p;
+        v++;
+        pv *= p;
+    }
+    if (v % 2 == 1)
+    {
+        return false;
+    }
+    long pk = _f.getOrder() / pv;
+    long root = sqrtUnit(u % pk, p, _f.getDegree() - v, pk);
+    if (root < 0)
+    {
+        return false;
+    }
+    long half = 1;
+    for (long i = 0; i < v / 2; i++)
+    {
+        half *= p;
+    }
+    res = _f.createNumber(multiplyModulo(root, half, _f.getOrder()));
+    return true;
+}
+
 /**
  * @param other The object to add to this GFNumber.
  * @return The addition GFNumber of this and given GFNumber object.
@@ -258,7 +902,7 @@ bool GFNumber::getIsPrime() const
 GFNumber GFNumber::operator+(const GFNumber& other) const
 {
     assert(_f == other.getField());
-    return _f.createNumber(_n + other.getNumber());
+    return _f.createNumber(_add(other.getNumber()));
 }
 
 /**
@@ -267,7 +911,7 @@ GFNumber GFNumber::operator+(const GFNumber& other) const
  */
 GFNumber GFNumber::operator+(const long& i) const
 {
-    return _f.createNumber(_n + i);
+    return _f.createNumber(_add(i));
 }
 
 /**
@@ -278,7 +922,7 @@ GFNumber GFNumber::operator+(const long& i) const
 GFNumber& GFNumber::operator+=(const GFNumber& other)
 {
     assert(_f == other.getField());
-    _n = (_n + other.getNumber()) % _f.getOrder();
+    _n = _modulo(_add(other.getNumber()));
     return *this;
 }
 
@@ -289,7 +933,7 @@ GFNumber& GFNumber::operator+=(const GFNumber& other)
  */
 GFNumber& GFNumber::operator+=(const long& i)
 {
-    _n = _modulo(_n + i);
+    _n = _modulo(_add(i));
     return *this;
 }
 
@@ -300,7 +944,7 @@ GFNumber& GFNumber::operator+=(const long& i)
 GFNumber GFNumber::operator-(const GFNumber& other) const
 {
     assert(_f == other.getField());
-    return _f.createNumber(_n - other.getNumber());
+    return _f.createNumber(_subtract(other.getNumber()));
 }
 
 /**
@@ -309,7 +953,7 @@ GFNumber GFNumber::operator-(const GFNumber& other) const
  */
 GFNumber GFNumber::operator-(const long& i) const
 {
-    return _f.createNumber(_n - i);
+    return _f.createNumber(_subtract(i));
 }
 
 /**
@@ -320,7 +964,7 @@ GFNumber GFNumber::operator-(const long& i) const
 GFNumber& GFNumber::operator-=(const GFNumber& other)
 {
     assert(_f == other.getField());
-    _n = _modulo(_n - other.getNumber());
+    _n = _modulo(_subtract(other.getNumber()));
     return *this;
 }
 
@@ -331,7 +975,7 @@ GFNumber& GFNumber::operator-=(const GFNumber& other)
  */
 GFNumber& GFNumber::operator-=(const long& i)
 {
-    _n = _modulo(_n - i);
+    _n = _modulo(_subtract(i));
     return *this;
 }
 
@@ -342,7 +986,7 @@ GFNumber& GFNumber::operator-=(const long& i)
 GFNumber GFNumber::operator*(const GFNumber& other) const
 {
     assert(_f == other.getField());
-    return _f.createNumber(_n * other.getNumber());
+    return _f.createNumber(_multiply(other.getNumber()));
 }
 
 /**
@@ -351,7 +995,7 @@ GFNumber GFNumber::operator*(const GFNumber& other) const
  */
 GFNumber GFNumber::operator*(const long& i) const
 {
-    return _f.createNumber(_n * i);
+    return _f.createNumber(_multiply(i));
 }
 
 /**
@@ -362,7 +1006,7 @@ GFNumber GFNumber::operator*(const long& i) const
 GFNumber& GFNumber::operator*=(const GFNumber& other)
 {
     assert(_f == other.getField());
-    _n = (_n * other.getNumber()) % _f.getOrder();
+    _n = _modulo(_multiply(other.getNumber()));
     return *this;
 }
 
@@ -373,7 +1017,7 @@ GFNumber& GFNumber::operator*=(const GFNumber& other)
  */
 GFNumber& GFNumber::operator*=(const long& i)
 {
-    _n = _modulo(_n * i);
+    _n = _modulo(_multiply(i));
     return *this;
 }
 
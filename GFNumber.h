@@ -1,6 +1,7 @@
 #ifndef EX1_GFNUMBER_H
 #define EX1_GFNUMBER_H
 
+#include "GFArena.h"
 #include "GField.h"
 
 
@@ -18,6 +19,27 @@ private:
      */
     long _modulo(const long& n) const;
 
+    /**
+     * Multiplies n by the given long without overflowing.
+     * @param i The long to multiply by.
+     * @return The product modulo the order, it may be negative when i is.
+     */
+    long _multiply(const long& i) const;
+
+    /**
+     * Adds the given long to n without overflowing.
+     * @param i The long to add.
+     * @return The sum modulo the order, it may be negative when i is.
+     */
+    long _add(const long& i) const;
+
+    /**
+     * Subtracts the given long from n without overflowing.
+     * @param i The long to subtract.
+     * @return The difference modulo the order, it may be negative.
+     */
+    long _subtract(const long& i) const;
+
     /**
      * Finds a prime factor of this GFNumber by Pollard Rho algorithm, and put it to the given res
      * reference.
@@ -58,6 +80,48 @@ private:
      */
     void _trialDivision(GFNumber*& result, int& counter, int *arrLength);
 
+    /**
+     * Finds all the prime factors of this GFNumber, and add them to the given result array.
+     * @param result The array that will contain all the prime factors.
+     * @param counter The current number of GFNumber objects in the array.
+     * @param arrLength The current array capacity.
+     */
+    void _factor(GFNumber*& result, int& counter, int *arrLength) const;
+
+    /**
+     * Finds the discrete logarithm in a subgroup of prime order by baby-step giant-step, with the
+     * baby steps in an open addressing hash table.
+     * @param f The field.
+     * @param g The generator of the subgroup.
+     * @param h An element of the subgroup.
+     * @param q The prime order of g.
+     * @return x in [0, q) with g**x = h, or -1 if there is none.
+     */
+    static long _babyStepGiantStep(const GField& f, const long& g, const long& h, const long& q);
+
+    /**
+     * Finds the discrete logarithm in a subgroup of prime order by Pollard's kangaroo algorithm.
+     * @param f The field.
+     * @param g The generator of the subgroup.
+     * @param h An element of the subgroup.
+     * @param q The prime order of g.
+     * @return x in [0, q) with g**x = h, or -1 if the kangaroos didn't meet.
+     */
+    static long _kangaroo(const GField& f, const long& g, const long& h, const long& q);
+
+    /**
+     * Finds the discrete logarithm in a subgroup of prime power order, digit by digit in base q.
+     * @param f The field.
+     * @param g An element whose order is a power of q.
+     * @param h Another element whose order is a power of q.
+     * @param q The prime.
+     * @param e The largest power of q that the order of g can be.
+     * @param modulus Reference to the order of g.
+     * @return x in [0, modulus) with g**x = h, or -1 if there is none.
+     */
+    static long _primePowerLog(const GField& f, const long& g, const long& h, const long& q,
+                               const int& e, long& modulus);
+
 public:
     /**
      * Two arguments constructor.
@@ -106,6 +170,16 @@ public:
      */
     GFNumber *getPrimeFactors(int *arrLength) const;
 
+    /**
+     * Finds all the prime factors of this GFNumber like getPrimeFactors, but keeps the array in the
+     * given arena instead of the heap - it must not be deleted, and it's freed when the arena is
+     * reset or rewound before it.
+     * @param arrLength The array length pointer.
+     * @param arena The arena to keep the array in.
+     * @return The array of the prime factors, if n is prime - the array will be empty.
+     */
+    GFNumber *getPrimeFactors(int *arrLength, GFArena& arena) const;
+
     /**
      * Print all the prime factors of this GFNumber.
      */
@@ -117,6 +191,82 @@ public:
      */
     bool getIsPrime() const;
 
+    /**
+     * Finds the discrete logarithm of this GFNumber to the given base, in the multiplicative group
+     * of the field (of the extension field when l > 1). With the cached factorization of the group
+     * order, the logarithm is found in every prime power subgroup by Pohlig-Hellman and joined by
+     * the CRT.
+     * @param base A non zero GFNumber of the same field.
+     * @return The smallest x >= 0 with base**x = n, or -1 if there is none.
+     */
+    long discreteLog(const GFNumber& base) const;
+
+    /**
+     * Finds the multiplicative order of this GFNumber in the field (in the extension field when
+     * l > 1), with the cached factorization of the group order.
+     * @return The smallest k > 0 with n**k = 1, n must not be 0.
+     */
+    long multiplicativeOrder() const;
+
+    /**
+     * Adds the given GFNumber as an element of the extension field GF(p**l) - the base p digits of
+     * n are the coefficients of a polynomial over GF(p). Unlike operator+, no carries pass between
+     * the coefficients.
+     * @param other The object to add to this GFNumber.
+     * @return The sum of the elements.
+     */
+    GFNumber fieldAdd(const GFNumber& other) const;
+
+    /**
+     * Subtracts the given GFNumber as an element of the extension field.
+     * @param other The object to subtract from this GFNumber.
+     * @return The difference of the elements.
+     */
+    GFNumber fieldSubtract(const GFNumber& other) const;
+
+    /**
+     * Multiplies by the given GFNumber as an element of the extension field - the product of the
+     * polynomials modulo the irreducible polynomial of the field.
+     * @param other The object to multiply this GFNumber by.
+     * @return The product of the elements.
+     */
+    GFNumber fieldMultiply(const GFNumber& other) const;
+
+    /**
+     * Finds the inverse of this GFNumber as an element of the extension field.
+     * @return The multiplicative inverse, n must not be 0.
+     */
+    GFNumber fieldInverse() const;
+
+    /**
+     * Finds the B-smooth part of n - its largest divisor whose prime factors are all at most B,
+     * without factoring it.
+     * @param bound The bound B.
+     * @return The smooth part, in the field of this GFNumber (0 if n is 0).
+     */
+    GFNumber smoothPart(const long& bound) const;
+
+    /**
+     * @param bound The bound B.
+     * @return true if n is positive and all its prime factors are at most B, false otherwise.
+     */
+    bool isSmooth(const long& bound) const;
+
+    /**
+     * Finds the inverse of this GFNumber modulo p**l (unlike fieldInverse, of the integer n) - it's
+     * found modulo p, and lifted by Newton's iteration, doubling the precision every step.
+     * @return The multiplicative inverse, n must not be divisible by p.
+     */
+    GFNumber inverse() const;
+
+    /**
+     * Finds a square root of this GFNumber modulo p**l - it's found modulo p by Tonelli-Shanks, and
+     * lifted by Hensel's lemma, doubling the precision every step.
+     * @param res Reference to the square root.
+     * @return true if n is a square modulo p**l, false otherwise.
+     */
+    bool sqrt(GFNumber& res) const;
+
     /**
      * @param other Reference to another GFNumber object.
      * @return This object after putting in its data members the other's data members.
@@ -0,0 +1,287 @@
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "GFParser.h"
+#include "GFStats.h"
+
+/**
+ * Defines the size of a block that is read at once when the input can't be mapped.
+ */
+const size_t PARSER_BLOCK_SIZE = 1 << 20;
+
+/**
+ * Checks if the given char separates two integers.
+ * @param c The char to check.
+ * @return true if c is a whitespace, false otherwise.
+ */
+static inline bool isSeparator(const char& c)
+{
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+/**
+ * Constructor that reads the records from the given file.
+ * @param path The path of the file to read.
+ */
+GFParser::GFParser(const char *path) : _fd(open(path, O_RDONLY)), _ownFd(true)
+{
+    _init();
+}
+
+/**
+ * Constructor that reads the records from the given bytes, without copying them.
+ * @param data The bytes to read, they must outlive the parser.
+ * @param size The amount of bytes.
+ */
+GFParser::GFParser(const char *data, const size_t& size) : _fd(-1), _ownFd(false), _mapped(false),
+                                                          _eof(true), _fail(false), _data(data),
+                                                          _buffer(nullptr), _size(size), _pos(0),
+                                                          _fieldsCount(0), _lastField(0),
+                                                          _nextVictim(0) {}
+
+/**
+ * Default constructor - reads the records from the standard input.
+ */
+GFParser::GFParser() : _fd(STDIN_FILENO), _ownFd(false)
+{
+    _init();
+}
+
+/**
+ * Destructor for the GFParser object.
+ */
+GFParser::~GFParser()
+{
+    if (_mapped)
+    {
+        munmap(const_cast<char *>(_data), _size);
+    }
+    delete[] _buffer;
+    if (_ownFd && _fd >= 0)
+    {
+        close(_fd);
+    }
+}
+
+/**
+ * Maps the opened file into memory, or allocates the block buffer if it can't be mapped.
+ */
+void GFParser::_init()
+{
+    _mapped = false;
+    _eof = false;
+    _fail = false;
+    _data = nullptr;
+    _buffer = nullptr;
+    _size = 0;
+    _pos = 0;
+    _fieldsCount = 0;
+    _lastField = 0;
+    _nextVictim = 0;
+    if (_fd < 0)
+    {
+        _eof = true;
+        _fail = true;
+        return;
+    }
+    struct stat info;
+    if (fstat(_fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0)
+    {
+        void *map = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, _fd, 0);
+        if (map != MAP_FAILED)
+        {
+            madvise(map, info.st_size, MADV_SEQUENTIAL);
+            _data = static_cast<const char *>(map);
+            _size = info.st_size;
+            _mapped = true;
+            _eof = true;
+            return;
+        }
+    }
+    _buffer = new char[PARSER_BLOCK_SIZE];
+    _data = _buffer;
+}
+
+/**
+ * Moves the unread bytes to the start of the block buffer and reads the next block after them.
+ * @return true if new bytes were read, false otherwise.
+ */
+bool GFParser::_refill()
+{
+    if (_eof || _size - _pos == PARSER_BLOCK_SIZE)
+    {
+        return false;
+    }
+    _size -= _pos;
+    std::memmove(_buffer, _buffer + _pos, _size);
+    _pos = 0;
+    while (true)
+    {
+        ssize_t got = read(_fd, _buffer + _size, PARSER_BLOCK_SIZE - _size);
+        if (got < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (got <= 0)
+        {
+            _eof = true;
+            _fail = _fail || got < 0;
+            return false;
+        }
+        _size += got;
+        return true;
+    }
+}
+
+/**
+ * Parses the next whitespace separated integer, with an optional sign - a '+' can't be followed by
+ * another sign.
+ * @param res A reference to the parsed integer.
+ * @return true if an integer was parsed, false at the end of the input or on invalid input.
+ */
+bool GFParser::nextLong(long& res)
+{
+    while (true)
+    {
+        while (_pos < _size && isSeparator(_data[_pos]))
+        {
+            _pos++;
+        }
+        if (_pos == _size)
+        {
+            if (!_refill())
+            {
+                return false;
+            }
+            continue;
+        }
+        size_t end = _pos;
+        while (end < _size && !isSeparator(_data[end]))
+        {
+            end++;
+        }
+        if (end == _size && _refill())
+        {
+            continue;
+        }
+        const char *first = _data + _pos;
+        bool plus = *first == '+';
+        if (plus)
+        {
+            first++;
+        }
+        std::from_chars_result parsed = std::from_chars(first, _data + end, res);
+        if ((plus && first < _data + end && *first == '-') || parsed.ec != std::errc() ||
+            parsed.ptr != _data + end)
+        {
+            _fail = true;
+            return false;
+        }
+        _pos = end;
+        return true;
+    }
+}
+
+/**
+ * Finds the given field in the memo, and validates and adds it if it's not there.
+ * @param p The char of the field.
+ * @param l The degree of the field.
+ * @return The index of the field in the memo, or -1 if the field is invalid.
+ */
+int GFParser::_findField(const long& p, const long& l)
+{
+    const GField& last = _fields[_lastField];
+    if (_fieldsCount > 0 && last.getChar() == std::abs(p) && last.getDegree() == l)
+    {
+        GF_STATS_COUNT(CACHE_HITS, 1);
+        return _lastField;
+    }
+    for (int i = 0; i < _fieldsCount; i++)
+    {
+        if (_fields[i].getChar() == std::abs(p) && _fields[i].getDegree() == l)
+        {
+            GF_STATS_COUNT(CACHE_HITS, 1);
+            _lastField = i;
+            return i;
+        }
+    }
+    if (!GField::isValid(p, l))
+    {
+        return -1;
+    }
+    int index = _nextVictim;
+    if (_fieldsCount < PARSER_FIELDS_MEMO)
+    {
+        index = _fieldsCount++;
+    }
+    else
+    {
+        _nextVictim = (_nextVictim + 1) % PARSER_FIELDS_MEMO;
+    }
+    _fields[index] = GField(p, l);
+    _orders[index] = _fields[index].getOrder();
+    _lastField = index;
+    return index;
+}
+
+/**
+ * Reads the next record as a raw residue and its field.
+ * @param n A reference to the residue, already reduced to the field.
+ * @param f A reference to a pointer to the field, valid until the next call.
+ * @return true if a record was read, false at the end of the input or on invalid input.
+ */
+bool GFParser::nextResidue(long& n, const GField*& f)
+{
+    long num, p, l;
+    if (!nextLong(num))
+    {
+        return false;
+    }
+    if (!nextLong(p) || !nextLong(l))
+    {
+        _fail = true;
+        return false;
+    }
+    int index = _findField(p, l);
+    if (index < 0)
+    {
+        _fail = true;
+        return false;
+    }
+    n = num % _orders[index];
+    if (n < 0)
+    {
+        n += _orders[index];
+    }
+    f = &_fields[index];
+    return true;
+}
+
+/**
+ * Reads the next record and put it into the given obj.
+ * @param obj GFNumber object to put the record in.
+ * @return true if a record was read, false at the end of the input or on invalid input.
+ */
+bool GFParser::nextNumber(GFNumber& obj)
+{
+    long n;
+    const GField *f;
+    if (!nextResidue(n, f))
+    {
+        return false;
+    }
+    obj = GFNumber(n, *f);
+    return true;
+}
+
+/**
+ * @return true if the parsing stopped because of invalid input, false otherwise.
+ */
+bool GFParser::fail() const
+{
+    return _fail;
+}
@@ -0,0 +1,111 @@
+#ifndef EX1_GFPARSER_H
+#define EX1_GFPARSER_H
+
+#include <cstddef>
+#include "GFNumber.h"
+
+/**
+ * Defines the number of distinct fields the parser remembers as already validated.
+ */
+const int PARSER_FIELDS_MEMO = 8;
+
+/**
+ * GFParser class, that reads GFNumber records ("n p l") from a file, from memory or from the
+ * standard input. A regular file is mapped into memory, any other input is read in large blocks,
+ * and the numbers are parsed in place without going through the formatted stream extraction.
+ */
+class GFParser
+{
+private:
+    int _fd;
+    bool _ownFd, _mapped, _eof, _fail;
+    const char *_data;
+    char *_buffer;
+    size_t _size, _pos;
+    GField _fields[PARSER_FIELDS_MEMO];
+    long _orders[PARSER_FIELDS_MEMO];
+    int _fieldsCount, _lastField, _nextVictim;
+
+    /**
+     * Maps the opened file into memory, or allocates the block buffer if it can't be mapped.
+     */
+    void _init();
+
+    /**
+     * Moves the unread bytes to the start of the block buffer and reads the next block after them.
+     * @return true if new bytes were read, false otherwise.
+     */
+    bool _refill();
+
+    /**
+     * Finds the given field in the memo, and validates and adds it if it's not there.
+     * @param p The char of the field.
+     * @param l The degree of the field.
+     * @return The index of the field in the memo, or -1 if the field is invalid.
+     */
+    int _findField(const long& p, const long& l);
+
+public:
+    /**
+     * Constructor that reads the records from the given file.
+     * @param path The path of the file to read.
+     */
+    GFParser(const char *path);
+
+    /**
+     * Constructor that reads the records from the given bytes, without copying them.
+     * @param data The bytes to read, they must outlive the parser.
+     * @param size The amount of bytes.
+     */
+    GFParser(const char *data, const size_t& size);
+
+    /**
+     * Default constructor - reads the records from the standard input.
+     */
+    GFParser();
+
+    /**
+     * The parser owns its mapping and buffer, so it can't be copied.
+     */
+    GFParser(const GFParser& other) = delete;
+
+    /**
+     * Destructor for the GFParser object.
+     */
+    ~GFParser();
+
+    /**
+     * The parser owns its mapping and buffer, so it can't be assigned.
+     */
+    GFParser& operator=(const GFParser& other) = delete;
+
+    /**
+     * Parses the next whitespace separated integer, with an optional sign - a '+' can't be followed
+     * by another sign.
+     * @param res A reference to the parsed integer.
+     * @return true if an integer was parsed, false at the end of the input or on invalid input.
+     */
+    bool nextLong(long& res);
+
+    /**
+     * Reads the next record as a raw residue and its field.
+     * @param n A reference to the residue, already reduced to the field.
+     * @param f A reference to a pointer to the field, valid until the next call.
+     * @return true if a record was read, false at the end of the input or on invalid input.
+     */
+    bool nextResidue(long& n, const GField*& f);
+
+    /**
+     * Reads the next record and put it into the given obj.
+     * @param obj GFNumber object to put the record in.
+     * @return true if a record was read, false at the end of the input or on invalid input.
+     */
+    bool nextNumber(GFNumber& obj);
+
+    /**
+     * @return true if the parsing stopped because of invalid input, false otherwise.
+     */
+    bool fail() const;
+};
+
+#endif //EX1_GFPARSER_H
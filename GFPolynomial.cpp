@@ -0,0 +1,733 @@
+#include <algorithm>
+#include <cassert>
+#include "GFPolynomial.h"
+
+/**
+ * Defines the size under which products are calculated by the schoolbook method.
+ */
+const size_t KARATSUBA_THRESHOLD = 32;
+
+/**
+ * Defines the size from which products are calculated by the number theoretic transform.
+ */
+const size_t NTT_THRESHOLD = 64;
+
+/**
+ * Defines the quotient size from which divisions use the Newton inverse of the divisor.
+ */
+const size_t NEWTON_DIVISION_THRESHOLD = 64;
+
+/**
+ * Defines the amount of points from which multipoint evaluation uses the subproduct tree.
+ */
+const int SUBPRODUCT_THRESHOLD = 16;
+
+/**
+ * Calculates the product of two residues modulo p, without overflowing.
+ * @param a The first residue.
+ * @param b The second residue.
+ * @param p The modulo.
+ * @return a * b modulo p.
+ */
+static inline long mulMod(const long& a, const long& b, const long& p)
+{
+    return (long) ((__int128) a * b % p);
+}
+
+/**
+ * Raises a residue to the given power modulo p.
+ * @param a The residue.
+ * @param e The non negative exponent.
+ * @param p The modulo.
+ * @return a to the power of e modulo p.
+ */
+static long powMod(long a, long e, const long& p)
+{
+    long res = 1 % p;
+    for (; e > 0; e >>= 1)
+    {
+        if (e & 1)
+        {
+            res = mulMod(res, a, p);
+        }
+        a = mulMod(a, a, p);
+    }
+    return res;
+}
+
+/**
+ * Constructor of the zero polynomial.
+ * @param f The GField of the coefficients.
+ */
+GFPolynomial::GFPolynomial(const GField& f) : _f(f), _p(f.getChar()), _prime(f.getDegree() == 1)
+{}
+
+/**
+ * Constructor that gets the coefficients as residues.
+ * @param f The GField of the coefficients.
+ * @param coeffs The coefficients, from the free one up.
+ */
+GFPolynomial::GFPolynomial(const GField& f, const std::vector<long>& coeffs) : GFPolynomial(f)
+{
+    _c = coeffs;
+    long order = f.getOrder();
+    for (long& c : _c)
+    {
+        c %= order;
+        c = (c < 0) ? c + order : c;
+    }
+    _trim();
+}
+
+/**
+ * Constructor that gets the coefficients as an array of GFNumber objects of the same field.
+ * @param coeffs The coefficients, from the free one up.
+ * @param len The amount of coefficients, at least 1.
+ */
+GFPolynomial::GFPolynomial(const GFNumber *coeffs, const int& len) :
+        GFPolynomial(coeffs[0].getField())
+{
+    assert(len > 0);
+    _c.resize(len);
+    for (int i = 0; i < len; i++)
+    {
+        assert(coeffs[i].getField() == _f);
+        _c[i] = coeffs[i].getNumber();
+    }
+    _trim();
+}
+
+/**
+ * Removes the leading zero coefficients.
+ */
+void GFPolynomial::_trim()
+{
+    while (!_c.empty() && _c.back() == 0)
+    {
+        _c.pop_back();
+    }
+}
+
+/**
+ * Adds two elements without overflowing, even when p is larger than 2**62.
+ * @param a The first field element.
+ * @param b The second field element.
+ * @return The sum of the elements.
+ */
+long GFPolynomial::_add(const long& a, const long& b) const
+{
+    if (_prime)
+    {
+        return (a >= _p - b) ? a - (_p - b) : a + b;
+    }
+    return _f.addElements(a, b);
+}
+
+/**
+ * Subtracts two elements without overflowing, even when p is larger than 2**62.
+ * @param a The first field element.
+ * @param b The second field element.
+ * @return The difference of the elements.
+ */
+long GFPolynomial::_sub(const long& a, const long& b) const
+{
+    if (_prime)
+    {
+        return (a >= b) ? a - b : a + (_p - b);
+    }
+    return _f.subtractElements(a, b);
+}
+
+/**
+ * @param a The first field element.
+ * @param b The second field element.
+ * @return The product of the elements.
+ */
+long GFPolynomial::_mul(const long& a, const long& b) const
+{
+    if (_prime)
+    {
+        return mulMod(a, b, _p);
+    }
+    return _f.multiplyElements(a, b);
+}
+
+/**
+ * @param a A non zero field element.
+ * @return The inverse of the element.
+ */
+long GFPolynomial::_inv(const long& a) const
+{
+    assert(a != 0);
+    if (_prime)
+    {
+        return powMod(a, _p - 2, _p);
+    }
+    return _f.inverseElement(a);
+}
+
+/**
+ * Multiplies two coefficient arrays by the schoolbook method.
+ * @param a The first array.
+ * @param b The second array.
+ * @return The product array.
+ */
+std::vector<long> GFPolynomial::_schoolbook(const std::vector<long>& a,
+                                            const std::vector<long>& b) const
+{
+    if (a.empty() || b.empty())
+    {
+        return std::vector<long>();
+    }
+    std::vector<long> res(a.size() + b.size() - 1, 0);
+    for (size_t i = 0; i < a.size(); i++)
+    {
+        for (size_t j = 0; a[i] != 0 && j < b.size(); j++)
+        {
+            res[i + j] = _add(res[i + j], _mul(a[i], b[j]));
+        }
+    }
+    return res;
+}
+
+/**
+ * Multiplies two coefficient arrays by Karatsuba's method - splits both in the middle, and finds
+ * the three products (low, high and the sums) recursively.
+ * @param a The first array.
+ * @param b The second array.
+ * @return The product array.
+ */
+std::vector<long> GFPolynomial::_karatsuba(const std::vector<long>& a,
+                                           const std::vector<long>& b) const
+{
+    if (std::min(a.size(), b.size()) <= KARATSUBA_THRESHOLD)
+    {
+        return _schoolbook(a, b);
+    }
+    size_t half = std::max(a.size(), b.size()) / 2;
+    std::vector<long> aLow(a.begin(), a.begin() + std::min(half, a.size()));
+    std::vector<long> aHigh(a.begin() + std::min(half, a.size()), a.end());
+    std::vector<long> bLow(b.begin(), b.begin() + std::min(half, b.size()));
+    std::vector<long> bHigh(b.begin() + std::min(half, b.size()), b.end());
+    std::vector<long> low = _karatsuba(aLow, bLow);
+    std::vector<long> high = _karatsuba(aHigh, bHigh);
+    std::vector<long> aSum(std::max(aLow.size(), aHigh.size()), 0);
+    std::vector<long> bSum(std::max(bLow.size(), bHigh.size()), 0);
+    for (size_t i = 0; i < aSum.size(); i++)
+    {
+        aSum[i] = _add(i < aLow.size() ? aLow[i] : 0, i < aHigh.size() ? aHigh[i] : 0);
+    }
+    for (size_t i = 0; i < bSum.size(); i++)
+    {
+        bSum[i] = _add(i < bLow.size() ? bLow[i] : 0, i < bHigh.size() ? bHigh[i] : 0);
+    }
+    std::vector<long> middle = _karatsuba(aSum, bSum);
+    std::vector<long> res(a.size() + b.size() - 1, 0);
+    for (size_t i = 0; i < low.size(); i++)
+    {
+        res[i] = _add(res[i], low[i]);
+        middle[i] = _sub(middle[i], low[i]);
+    }
+    for (size_t i = 0; i < high.size(); i++)
+    {
+        res[i + 2 * half] = _add(res[i + 2 * half], high[i]);
+        middle[i] = _sub(middle[i], high[i]);
+    }
+    for (size_t i = 0; i < middle.size() && i + half < res.size(); i++)
+    {
+        res[i + half] = _add(res[i + half], middle[i]);
+    }
+    return res;
+}
+
+/**
+ * Finds a primitive root of unity of the given order, if the field has one. For p - 1 = 2**k * m,
+ * c**m has an order that divides 2**k, and it's exactly 2**k when c is a quadratic non residue.
+ * @param n The order, a power of two.
+ * @return The root, or 0 if GF(p) has no root of unity of order n.
+ */
+long GFPolynomial::_rootOfUnity(const size_t& n) const
+{
+    if (!_prime || _p == 2)
+    {
+        return 0;
+    }
+    long odd = _p - 1;
+    long twos = 1;
+    while (odd % 2 == 0)
+    {
+        odd /= 2;
+        twos *= 2;
+    }
+    if ((long) n > twos)
+    {
+        return 0;
+    }
+    for (long c = 2; c < _p; c++)
+    {
+        long root = powMod(c, odd, _p);
+        if (powMod(root, twos / 2, _p) != 1)
+        {
+            return powMod(root, twos / (long) n, _p);
+        }
+    }
+    return 0;
+}
+
+/**
+ * Transforms the given array in place by the iterative radix 2 number theoretic transform.
+ * @param a The array, its size is a power of two.
+ * @param root A primitive root of unity of the order of the array size.
+ */
+void GFPolynomial::_ntt(std::vector<long>& a, const long& root) const
+{
+    size_t n = a.size();
+    for (size_t i = 1, j = 0; i < n; i++)
+    {
+        size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1)
+        {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j)
+        {
+            std::swap(a[i], a[j]);
+        }
+    }
+    for (size_t len = 2; len <= n; len <<= 1)
+    {
+        long step = powMod(root, (long) (n / len), _p);
+        for (size_t i = 0; i < n; i += len)
+        {
+            long w = 1;
+            for (size_t j = 0; j < len / 2; j++)
+            {
+                long u = a[i + j];
+                long v = mulMod(a[i + j + len / 2], w, _p);
+                a[i + j] = _add(u, v);
+                a[i + j + len / 2] = _sub(u, v);
+                w = mulMod(w, step, _p);
+            }
+        }
+    }
+}
+
+/**
+ * Multiplies two coefficient arrays by the fastest available method.
+ * @param a The first array.
+ * @param b The second array.
+ * @return The product array.
+ */
+std::vector<long> GFPolynomial::_multiply(const std::vector<long>& a,
+                                          const std::vector<long>& b) const
+{
+    if (a.empty() || b.empty())
+    {
+        return std::vector<long>();
+    }
+    size_t resSize = a.size() + b.size() - 1;
+    size_t n = 1;
+    while (n < resSize)
+    {
+        n <<= 1;
+    }
+    long root = (std::min(a.size(), b.size()) >= NTT_THRESHOLD) ? _rootOfUnity(n) : 0;
+    if (root == 0)
+    {
+        return _karatsuba(a, b);
+    }
+    std::vector<long> fa(a), fb(b);
+    fa.resize(n, 0);
+    fb.resize(n, 0);
+    _ntt(fa, root);
+    _ntt(fb, root);
+    for (size_t i = 0; i < n; i++)
+    {
+        fa[i] = mulMod(fa[i], fb[i], _p);
+    }
+    _ntt(fa, _inv(root));
+    long nInverse = _inv((long) (n % _p));
+    fa.resize(resSize);
+    for (long& c : fa)
+    {
+        c = mulMod(c, nInverse, _p);
+    }
+    return fa;
+}
+
+/**
+ * Finds the inverse of this polynomial as a power series, by Newton iteration - every step
+ * doubles the amount of correct coefficients by g = g * (2 - this * g).
+ * @param n The amount of series coefficients to find.
+ * @return The polynomial g with this * g = 1 modulo x**n.
+ */
+GFPolynomial GFPolynomial::_inverseSeries(const size_t& n) const
+{
+    assert(!_c.empty() && _c[0] != 0);
+    GFPolynomial res(_f, {_inv(_c[0])});
+    for (size_t known = 1; known < n;)
+    {
+        known = std::min(2 * known, n);
+        std::vector<long> head(_c.begin(), _c.begin() + std::min(known, _c.size()));
+        std::vector<long> error = _multiply(head, res._c);
+        error.resize(known, 0);
+        for (long& c : error)
+        {
+            c = _sub(0, c);
+        }
+        error[0] = _add(error[0], _add(1, 1));
+        res._c = _multiply(res._c, error);
+        res._c.resize(known, 0);
+        res._trim();
+    }
+    return res;
+}
+
+/**
+ * @return The GField of the coefficients.
+ */
+const GField& GFPolynomial::getField() const
+{
+    return _f;
+}
+
+/**
+ * @return The degree of the polynomial, -1 for the zero polynomial.
+ */
+long GFPolynomial::getDegree() const
+{
+    return (long) _c.size() - 1;
+}
+
+/**
+ * @param i The index of the coefficient.
+ * @return The coefficient of x**i.
+ */
+GFNumber GFPolynomial::getCoefficient(const long& i) const
+{
+    assert(i >= 0);
+    return _f.createNumber(i < (long) _c.size() ? _c[i] : 0);
+}
+
+/**
+ * @return The coefficients as residues, from the free one up.
+ */
+const std::vector<long>& GFPolynomial::getCoefficients() const
+{
+    return _c;
+}
+
+/**
+ * Evaluates the polynomial at the given point by Horner's rule.
+ * @param x The point.
+ * @return The value of the polynomial at x.
+ */
+GFNumber GFPolynomial::evaluate(const GFNumber& x) const
+{
+    assert(x.getField() == _f);
+    long res = 0;
+    for (size_t i = _c.size(); i > 0; i--)
+    {
+        res = _add(_mul(res, x.getNumber()), _c[i - 1]);
+    }
+    return _f.createNumber(res);
+}
+
+/**
+ * Builds the subproduct tree of the given points - the leaves are (x - x_i), and every node is
+ * the product of its two children.
+ * @param f The field of the points.
+ * @param xs The points.
+ * @return The tree levels, from the leaves up to the root.
+ */
+std::vector<std::vector<GFPolynomial>> GFPolynomial::_subproductTree(const GField& f,
+                                                                     const std::vector<long>& xs)
+{
+    std::vector<std::vector<GFPolynomial>> tree(1);
+    GFPolynomial zero(f);
+    for (const long& x : xs)
+    {
+        tree[0].push_back(GFPolynomial(f, {zero._sub(0, x), 1}));
+    }
+    while (tree.back().size() > 1)
+    {
+        const std::vector<GFPolynomial>& below = tree.back();
+        std::vector<GFPolynomial> level;
+        for (size_t i = 0; i < below.size(); i += 2)
+        {
+            level.push_back(i + 1 < below.size() ? below[i] * below[i + 1] : below[i]);
+        }
+        tree.push_back(level);
+    }
+    return tree;
+}
+
+/**
+ * Reduces the given polynomial down the subproduct tree, and puts its values at the points in
+ * the result array.
+ * @param tree The subproduct tree.
+ * @param level The level of the current node.
+ * @param index The index of the current node in its level.
+ * @param poly The polynomial, already reduced modulo the current node.
+ * @param res The values at the points.
+ */
+void GFPolynomial::_remainderTree(const std::vector<std::vector<GFPolynomial>>& tree,
+                                  const size_t& level, const size_t& index,
+                                  const GFPolynomial& poly, std::vector<long>& res)
+{
+    if (level == 0)
+    {
+        res[index] = poly._c.empty() ? 0 : poly._c[0];
+        return;
+    }
+    for (size_t child = 2 * index; child < 2 * index + 2; child++)
+    {
+        if (child < tree[level - 1].size())
+        {
+            _remainderTree(tree, level - 1, child, poly % tree[level - 1][child], res);
+        }
+    }
+}
+
+/**
+ * Evaluates the polynomial at many points, by reducing it down their subproduct tree.
+ * @param xs The points.
+ * @param len The amount of points.
+ * @param res The array to put the values in.
+ */
+void GFPolynomial::evaluate(const GFNumber *xs, const int& len, GFNumber *res) const
+{
+    if (len < SUBPRODUCT_THRESHOLD)
+    {
+        for (int i = 0; i < len; i++)
+        {
+            res[i] = evaluate(xs[i]);
+        }
+        return;
+    }
+    std::vector<long> points(len), values(len);
+    for (int i = 0; i < len; i++)
+    {
+        assert(xs[i].getField() == _f);
+        points[i] = xs[i].getNumber();
+    }
+    std::vector<std::vector<GFPolynomial>> tree = _subproductTree(_f, points);
+    _remainderTree(tree, tree.size() - 1, 0, *this % tree.back()[0], values);
+    for (int i = 0; i < len; i++)
+    {
+        res[i] = _f.createNumber(values[i]);
+    }
+}
+
+/**
+ * Finds the polynomial of degree smaller than len that passes through the given points, by
+ * their subproduct tree - with M the product of all (x - x_i), the weight of every point is
+ * y_i / M'(x_i), and the weighted sums are joined up the tree.
+ * @param xs The distinct points.
+ * @param ys The values at the points.
+ * @param len The amount of points, at least 1.
+ * @return The interpolating polynomial.
+ */
+GFPolynomial GFPolynomial::interpolate(const GFNumber *xs, const GFNumber *ys, const int& len)
+{
+    assert(len > 0);
+    const GField& f = xs[0].getField();
+    std::vector<long> points(len), derivatives(len);
+    for (int i = 0; i < len; i++)
+    {
+        assert(xs[i].getField() == f && ys[i].getField() == f);
+        points[i] = xs[i].getNumber();
+    }
+    std::vector<std::vector<GFPolynomial>> tree = _subproductTree(f, points);
+    const GFPolynomial& root = tree.back()[0];
+    GFPolynomial derivative(f);
+    for (size_t i = 1; i < root._c.size(); i++)
+    {
+        derivative._c.push_back(root._mul(root._c[i], (long) (i % root._p)));
+    }
+    derivative._trim();
+    _remainderTree(tree, tree.size() - 1, 0, derivative % root, derivatives);
+    std::vector<GFPolynomial> sums;
+    for (int i = 0; i < len; i++)
+    {
+        assert(derivatives[i] != 0);
+        long weight = root._mul(ys[i].getNumber(), root._inv(derivatives[i]));
+        sums.push_back(GFPolynomial(f, {weight}));
+    }
+    for (size_t level = 0; level + 1 < tree.size(); level++)
+    {
+        std::vector<GFPolynomial> joined;
+        for (size_t i = 0; i < sums.size(); i += 2)
+        {
+            if (i + 1 < sums.size())
+            {
+                joined.push_back(sums[i] * tree[level][i + 1] + sums[i + 1] * tree[level][i]);
+            }
+            else
+            {
+                joined.push_back(sums[i]);
+            }
+        }
+        sums = joined;
+    }
+    return sums[0];
+}
+
+/**
+ * Divides this polynomial by the given one, with remainder. Long quotients are found as the
+ * reversed dividend times the power series inverse of the reversed divisor.
+ * @param divisor The non zero polynomial to divide by.
+ * @param quotient Reference to the quotient.
+ * @param remainder Reference to the remainder, of degree smaller than the divisor's.
+ */
+void GFPolynomial::divide(const GFPolynomial& divisor, GFPolynomial& quotient,
+                          GFPolynomial& remainder) const
+{
+    assert(_f == divisor._f);
+    assert(!divisor._c.empty());
+    GFPolynomial q(_f);
+    if (_c.size() < divisor._c.size())
+    {
+        remainder = *this;
+        quotient = q;
+        return;
+    }
+    size_t qSize = _c.size() - divisor._c.size() + 1;
+    if (qSize < NEWTON_DIVISION_THRESHOLD || divisor._c.size() < KARATSUBA_THRESHOLD)
+    {
+        std::vector<long> rest = _c;
+        q._c.assign(qSize, 0);
+        long leadInverse = _inv(divisor._c.back());
+        for (size_t i = qSize; i > 0; i--)
+        {
+            long c = _mul(rest[i - 1 + divisor._c.size() - 1], leadInverse);
+            q._c[i - 1] = c;
+            for (size_t j = 0; c != 0 && j < divisor._c.size(); j++)
+            {
+                rest[i - 1 + j] = _sub(rest[i - 1 + j], _mul(c, divisor._c[j]));
+            }
+        }
+        rest.resize(divisor._c.size() - 1);
+        q._trim();
+        quotient = q;
+        remainder = GFPolynomial(_f);
+        remainder._c = rest;
+        remainder._trim();
+        return;
+    }
+    GFPolynomial reversedDivisor(_f);
+    reversedDivisor._c.assign(divisor._c.rbegin(), divisor._c.rend());
+    GFPolynomial inverse = reversedDivisor._inverseSeries(qSize);
+    std::vector<long> reversed(_c.rbegin(), _c.rbegin() + qSize);
+    q._c = _multiply(reversed, inverse._c);
+    q._c.resize(qSize, 0);
+    std::reverse(q._c.begin(), q._c.end());
+    q._trim();
+    quotient = q;
+    remainder = *this - q * divisor;
+}
+
+/**
+ * @param other The polynomial to add to this one.
+ * @return The sum of the polynomials.
+ */
+GFPolynomial GFPolynomial::operator+(const GFPolynomial& other) const
+{
+    assert(_f == other._f);
+    GFPolynomial res(*this);
+    res._c.resize(std::max(_c.size(), other._c.size()), 0);
+    for (size_t i = 0; i < other._c.size(); i++)
+    {
+        res._c[i] = _add(res._c[i], other._c[i]);
+    }
+    res._trim();
+    return res;
+}
+
+/**
+ * @param other The polynomial to subtract from this one.
+ * @return The difference of the polynomials.
+ */
+GFPolynomial GFPolynomial::operator-(const GFPolynomial& other) const
+{
+    assert(_f == other._f);
+    GFPolynomial res(*this);
+    res._c.resize(std::max(_c.size(), other._c.size()), 0);
+    for (size_t i = 0; i < other._c.size(); i++)
+    {
+        res._c[i] = _sub(res._c[i], other._c[i]);
+    }
+    res._trim();
+    return res;
+}
+
+/**
+ * @param other The polynomial to multiply this one by.
+ * @return The product of the polynomials.
+ */
+GFPolynomial GFPolynomial::operator*(const GFPolynomial& other) const
+{
+    assert(_f == other._f);
+    GFPolynomial res(_f);
+    res._c = _multiply(_c, other._c);
+    res._trim();
+    return res;
+}
+
+/**
+ * @param other The non zero polynomial to divide this one by.
+ * @return The quotient of the division.
+ */
+GFPolynomial GFPolynomial::operator/(const GFPolynomial& other) const
+{
+    GFPolynomial quotient(_f), remainder(_f);
+    divide(other, quotient, remainder);
+    return quotient;
+}
+
+/**
+ * @param other The non zero polynomial to divide this one by.
+ * @return The remainder of the division.
+ */
+GFPolynomial GFPolynomial::operator%(const GFPolynomial& other) const
+{
+    GFPolynomial quotient(_f), remainder(_f);
+    divide(other, quotient, remainder);
+    return remainder;
+}
+
+/**
+ * @param other Reference to another GFPolynomial object.
+ * @return true if the fields and the coefficients are equal, false otherwise.
+ */
+bool GFPolynomial::operator==(const GFPolynomial& other) const
+{
+    return _f == other._f && _c == other._c;
+}
+
+/**
+ * @param other Reference to another GFPolynomial object.
+ * @return true if the fields or the coefficients are different, false otherwise.
+ */
+bool GFPolynomial::operator!=(const GFPolynomial& other) const
+{
+    return !(*this == other);
+}
+
+/**
+ * Prints the coefficients, from the free one up, and the field to the given stream.
+ * @param s Out stream to print to.
+ * @param obj Object to print.
+ * @return The given out stream.
+ */
+std::ostream& operator<<(std::ostream& s, const GFPolynomial& obj)
+{
+    s << "[";
+    for (size_t i = 0; i < obj._c.size(); i++)
+    {
+        s << (i > 0 ? " " : "") << obj._c[i];
+    }
+    s << "] " << obj._f;
+    return s;
+}
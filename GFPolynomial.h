@@ -0,0 +1,268 @@
+#ifndef EX1_GFPOLYNOMIAL_H
+#define EX1_GFPOLYNOMIAL_H
+
+#include <vector>
+#include "GFNumber.h"
+
+/**
+ * GFPolynomial class, a polynomial with coefficients in a GField - f.
+ * The coefficients are kept as one contiguous array of residues, from the free coefficient up, and
+ * are added and multiplied as elements of the field (for l > 1 as elements of the extension field).
+ * Products use the number theoretic transform when the field is GF(p) and p - 1 has a large enough
+ * power of two, and Karatsuba multiplication otherwise.
+ */
+class GFPolynomial
+{
+private:
+    GField _f;
+    long _p;
+    bool _prime;
+    std::vector<long> _c;
+
+    /**
+     * Removes the leading zero coefficients.
+     */
+    void _trim();
+
+    /**
+     * Adds two elements without overflowing, even when p is larger than 2**62.
+     * @param a The first field element.
+     * @param b The second field element.
+     * @return The sum of the elements.
+     */
+    long _add(const long& a, const long& b) const;
+
+    /**
+     * Subtracts two elements without overflowing, even when p is larger than 2**62.
+     * @param a The first field element.
+     * @param b The second field element.
+     * @return The difference of the elements.
+     */
+    long _sub(const long& a, const long& b) const;
+
+    /**
+     * @param a The first field element.
+     * @param b The second field element.
+     * @return The product of the elements.
+     */
+    long _mul(const long& a, const long& b) const;
+
+    /**
+     * @param a A non zero field element.
+     * @return The inverse of the element.
+     */
+    long _inv(const long& a) const;
+
+    /**
+     * Multiplies two coefficient arrays by the schoolbook method.
+     * @param a The first array.
+     * @param b The second array.
+     * @return The product array.
+     */
+    std::vector<long> _schoolbook(const std::vector<long>& a, const std::vector<long>& b) const;
+
+    /**
+     * Multiplies two coefficient arrays by Karatsuba's method.
+     * @param a The first array.
+     * @param b The second array.
+     * @return The product array.
+     */
+    std::vector<long> _karatsuba(const std::vector<long>& a, const std::vector<long>& b) const;
+
+    /**
+     * Finds a primitive root of unity of the given order, if the field has one.
+     * @param n The order, a power of two.
+     * @return The root, or 0 if GF(p) has no root of unity of order n.
+     */
+    long _rootOfUnity(const size_t& n) const;
+
+    /**
+     * Transforms the given array in place by the number theoretic transform.
+     * @param a The array, its size is a power of two.
+     * @param root A primitive root of unity of the order of the array size.
+     */
+    void _ntt(std::vector<long>& a, const long& root) const;
+
+    /**
+     * Multiplies two coefficient arrays by the fastest available method.
+     * @param a The first array.
+     * @param b The second array.
+     * @return The product array.
+     */
+    std::vector<long> _multiply(const std::vector<long>& a, const std::vector<long>& b) const;
+
+    /**
+     * Finds the inverse of this polynomial as a power series, by Newton iteration.
+     * @param n The amount of series coefficients to find.
+     * @return The polynomial g with this * g = 1 modulo x**n.
+     */
+    GFPolynomial _inverseSeries(const size_t& n) const;
+
+    /**
+     * Builds the subproduct tree of the given points - the leaves are (x - x_i), and every node is
+     * the product of its two children.
+     * @param f The field of the points.
+     * @param xs The points.
+     * @return The tree levels, from the leaves up to the root.
+     */
+    static std::vector<std::vector<GFPolynomial>> _subproductTree(const GField& f,
+                                                                  const std::vector<long>& xs);
+
+    /**
+     * Reduces the given polynomial down the subproduct tree, and puts its values at the points in
+     * the result array.
+     * @param tree The subproduct tree.
+     * @param level The level of the current node.
+     * @param index The index of the current node in its level.
+     * @param poly The polynomial, already reduced modulo the current node.
+     * @param res The values at the points.
+     */
+    static void _remainderTree(const std::vector<std::vector<GFPolynomial>>& tree,
+                               const size_t& level, const size_t& index,
+                               const GFPolynomial& poly, std::vector<long>& res);
+
+public:
+    /**
+     * Constructor of the zero polynomial.
+     * @param f The GField of the coefficients.
+     */
+    GFPolynomial(const GField& f);
+
+    /**
+     * Constructor that gets the coefficients as residues.
+     * @param f The GField of the coefficients.
+     * @param coeffs The coefficients, from the free one up.
+     */
+    GFPolynomial(const GField& f, const std::vector<long>& coeffs);
+
+    /**
+     * Constructor that gets the coefficients as an array of GFNumber objects of the same field.
+     * @param coeffs The coefficients, from the free one up.
+     * @param len The amount of coefficients, at least 1.
+     */
+    GFPolynomial(const GFNumber *coeffs, const int& len);
+
+    /**
+     * Copy constructor.
+     * @param other The object to copy from.
+     */
+    GFPolynomial(const GFPolynomial& other) = default;
+
+    /**
+     * Destructor for the GFPolynomial object.
+     */
+    ~GFPolynomial() = default;
+
+    /**
+     * @return The GField of the coefficients.
+     */
+    const GField& getField() const;
+
+    /**
+     * @return The degree of the polynomial, -1 for the zero polynomial.
+     */
+    long getDegree() const;
+
+    /**
+     * @param i The index of the coefficient.
+     * @return The coefficient of x**i.
+     */
+    GFNumber getCoefficient(const long& i) const;
+
+    /**
+     * @return The coefficients as residues, from the free one up.
+     */
+    const std::vector<long>& getCoefficients() const;
+
+    /**
+     * Evaluates the polynomial at the given point by Horner's rule.
+     * @param x The point.
+     * @return The value of the polynomial at x.
+     */
+    GFNumber evaluate(const GFNumber& x) const;
+
+    /**
+     * Evaluates the polynomial at many points, by reducing it down their subproduct tree.
+     * @param xs The points.
+     * @param len The amount of points.
+     * @param res The array to put the values in.
+     */
+    void evaluate(const GFNumber *xs, const int& len, GFNumber *res) const;
+
+    /**
+     * Finds the polynomial of degree smaller than len that passes through the given points, by
+     * their subproduct tree.
+     * @param xs The distinct points.
+     * @param ys The values at the points.
+     * @param len The amount of points, at least 1.
+     * @return The interpolating polynomial.
+     */
+    static GFPolynomial interpolate(const GFNumber *xs, const GFNumber *ys, const int& len);
+
+    /**
+     * Divides this polynomial by the given one, with remainder.
+     * @param divisor The non zero polynomial to divide by.
+     * @param quotient Reference to the quotient.
+     * @param remainder Reference to the remainder, of degree smaller than the divisor's.
+     */
+    void divide(const GFPolynomial& divisor, GFPolynomial& quotient,
+                GFPolynomial& remainder) const;
+
+    /**
+     * @param other Reference to another GFPolynomial object.
+     * @return This object after putting in its data members the other's data members.
+     */
+    GFPolynomial& operator=(const GFPolynomial& other) = default;
+
+    /**
+     * @param other The polynomial to add to this one.
+     * @return The sum of the polynomials.
+     */
+    GFPolynomial operator+(const GFPolynomial& other) const;
+
+    /**
+     * @param other The polynomial to subtract from this one.
+     * @return The difference of the polynomials.
+     */
+    GFPolynomial operator-(const GFPolynomial& other) const;
+
+    /**
+     * @param other The polynomial to multiply this one by.
+     * @return The product of the polynomials.
+     */
+    GFPolynomial operator*(const GFPolynomial& other) const;
+
+    /**
+     * @param other The non zero polynomial to divide this one by.
+     * @return The quotient of the division.
+     */
+    GFPolynomial operator/(const GFPolynomial& other) const;
+
+    /**
+     * @param other The non zero polynomial to divide this one by.
+     * @return The remainder of the division.
+     */
+    GFPolynomial operator%(const GFPolynomial& other) const;
+
+    /**
+     * @param other Reference to another GFPolynomial object.
+     * @return true if the fields and the coefficients are equal, false otherwise.
+     */
+    bool operator==(const GFPolynomial& other) const;
+
+    /**
+     * @param other Reference to another GFPolynomial object.
+     * @return true if the fields or the coefficients are different, false otherwise.
+     */
+    bool operator!=(const GFPolynomial& other) const;
+
+    /**
+     * Prints the coefficients, from the free one up, and the field to the given stream.
+     * @param s Out stream to print to.
+     * @param obj Object to print.
+     * @return The given out stream.
+     */
+    friend std::ostream& operator<<(std::ostream& s, const GFPolynomial& obj);
+};
+
+#endif //EX1_GFPOLYNOMIAL_H
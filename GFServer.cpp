@@ -0,0 +1,502 @@
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <set>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "GFParser.h"
+#include "GFServer.h"
+
+/**
+ * Defines the maximal amount of requests a worker answers at once.
+ */
+const size_t SERVER_MAX_BATCH = 64;
+
+/**
+ * Defines the amount of bytes read from a client at once.
+ */
+const size_t SERVER_READ_SIZE = 1 << 16;
+
+/**
+ * Defines the longest line a client may send, a client whose line gets longer is dropped.
+ */
+const size_t SERVER_MAX_LINE = 1 << 12;
+
+/**
+ * Defines the amount of distinct fields the clients may use, since every field keeps its context
+ * until the program ends.
+ */
+const size_t SERVER_MAX_FIELDS = 1 << 10;
+
+/**
+ * Defines the amount of pending connections the socket keeps.
+ */
+const int SERVER_BACKLOG = 128;
+
+/**
+ * Defines the byte that wakes the poll loop because jobs were answered.
+ */
+const char WAKE_DONE = 'd';
+
+/**
+ * Defines the byte that wakes the poll loop to stop the server.
+ */
+const char WAKE_STOP = 'q';
+
+/**
+ * Defines the answer to an invalid request.
+ */
+const char *const ERROR_ANSWER = "error";
+
+/**
+ * Checks if a client may use the given field - a valid field that the clients already used, or a
+ * new one while they used less than SERVER_MAX_FIELDS fields, so an untrusted client can't make
+ * the server create contexts without a limit.
+ * @param p The char of the field.
+ * @param l The degree of the field.
+ * @return true if the field may be used, false otherwise.
+ */
+static bool admitField(const long& p, const long& l)
+{
+    static std::mutex lock;
+    static std::set<std::pair<long, long>> fields;
+    thread_local std::pair<long, long> last(0, 0);
+    std::pair<long, long> field(p, l);
+    if (l > 0 && field == last)
+    {
+        return true;
+    }
+    if (!GField::isValid(p, l))
+    {
+        return false;
+    }
+    std::lock_guard<std::mutex> guard(lock);
+    if (fields.size() >= SERVER_MAX_FIELDS && fields.count(field) == 0)
+    {
+        return false;
+    }
+    fields.insert(field);
+    last = field;
+    return true;
+}
+
+/**
+ * Reads the next "n p l" triple of the request and creates a GFNumber from it, if its field is
+ * valid - a prime char, a positive degree and an order that fits in a long - and admitted, since
+ * the line comes from an untrusted client.
+ * @param in The parser of the request.
+ * @param res Reference to the created GFNumber.
+ * @return true if a number was read, false otherwise.
+ */
+static bool readNumber(GFParser& in, GFNumber& res)
+{
+    long n, p, l;
+    if (!in.nextLong(n) || !in.nextLong(p) || !in.nextLong(l) || !admitField(p, l))
+    {
+        return false;
+    }
+    res = GFNumber(n, GField(p, l));
+    return true;
+}
+
+/**
+ * Sets the given file descriptor to non blocking mode.
+ * @param fd The file descriptor.
+ */
+static void setNonBlocking(const int& fd)
+{
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+}
+
+/**
+ * Constructor that gets two arguments.
+ * @param path The path of the Unix domain socket.
+ * @param workers The amount of worker threads.
+ */
+GFServer::GFServer(const std::string& path, const int& workers) : _path(path), _listenFd(-1),
+                                                                   _nextClientId(0),
+                                                                   _stopping(false)
+{
+    _wakePipe[0] = -1;
+    _wakePipe[1] = -1;
+    if (pipe(_wakePipe) == 0)
+    {
+        setNonBlocking(_wakePipe[0]);
+        setNonBlocking(_wakePipe[1]);
+    }
+    _workers.resize(std::max(workers, 1));
+}
+
+/**
+ * Destructor for the GFServer object, stops the workers and removes the socket.
+ */
+GFServer::~GFServer()
+{
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        _stopping = true;
+    }
+    _hasWork.notify_all();
+    for (std::thread& worker : _workers)
+    {
+        if (worker.joinable())
+        {
+            worker.join();
+        }
+    }
+    for (std::pair<const unsigned long, Client>& client : _clients)
+    {
+        close(client.second.fd);
+    }
+    if (_listenFd >= 0)
+    {
+        close(_listenFd);
+        unlink(_path.c_str());
+    }
+    close(_wakePipe[0]);
+    close(_wakePipe[1]);
+}
+
+/**
+ * Answers a single request line.
+ * @param line The request, without the new line.
+ * @return The answer, without the new line.
+ */
+std::string GFServer::answer(const std::string& line)
+{
+    size_t start = line.find_first_not_of(" \t\r");
+    if (start == std::string::npos)
+    {
+        return ERROR_ANSWER;
+    }
+    size_t pos = line.find_first_of(" \t\r", start);
+    std::string op = line.substr(start, pos - start);
+    pos = std::min(pos, line.size());
+    GFParser in(line.data() + pos, line.size() - pos);
+    GFNumber a, b;
+    if (op == "factor")
+    {
+        if (!readNumber(in, a))
+        {
+            return ERROR_ANSWER;
+        }
+        int arrLength = 0;
+        GFArena& arena = GFArena::local();
+        GFArena::Mark mark = arena.getMark();
+        GFNumber *primeFactors = a.getPrimeFactors(&arrLength, arena);
+        std::string res = std::to_string(a.getNumber()) + "=";
+        if (arrLength == 0)
+        {
+            res += std::to_string(a.getNumber()) + "*1";
+        }
+        for (int i = 0; i < arrLength; i++)
+        {
+            res += std::to_string(primeFactors[i].getNumber());
+            res += (i < arrLength - 1) ? "*" : "";
+        }
+        arena.rewind(mark);
+        return res;
+    }
+    if (!readNumber(in, a) || !readNumber(in, b) || a.getField() != b.getField())
+    {
+        return ERROR_ANSWER;
+    }
+    GFNumber res;
+    if (op == "add")
+    {
+        res = a + b;
+    }
+    else if (op == "sub")
+    {
+        res = a - b;
+    }
+    else if (op == "mul")
+    {
+        res = a * b;
+    }
+    else if (op == "mod" && b.getNumber() != 0)
+    {
+        res = a % b;
+    }
+    else
+    {
+        return ERROR_ANSWER;
+    }
+    const GField& f = res.getField();
+    return std::to_string(res.getNumber()) + " GF(" + std::to_string(f.getChar()) + "**" +
+           std::to_string(f.getDegree()) + ")";
+}
+
+/**
+ * Takes batches of jobs from the queue and answers them, until the server stops.
+ */
+void GFServer::_workerLoop()
+{
+    while (true)
+    {
+        std::vector<Job> batch;
+        {
+            std::unique_lock<std::mutex> guard(_lock);
+            _hasWork.wait(guard, [this] { return _stopping || !_pending.empty(); });
+            if (_stopping)
+            {
+                return;
+            }
+            batch = std::move(_pending.front());
+            _pending.pop_front();
+        }
+        for (Job& job : batch)
+        {
+            job.answer = answer(job.line);
+        }
+        bool wasEmpty;
+        {
+            std::lock_guard<std::mutex> guard(_lock);
+            wasEmpty = _done.empty();
+            for (Job& job : batch)
+            {
+                _done.push_back(std::move(job));
+            }
+        }
+        if (wasEmpty)
+        {
+            ssize_t done = write(_wakePipe[1], &WAKE_DONE, 1);
+            (void) done;
+        }
+    }
+}
+
+/**
+ * Reads everything the given client sent, and adds its complete lines to the batch. A client
+ * whose incomplete line is longer than SERVER_MAX_LINE is dropped once its earlier lines are
+ * answered.
+ * @param id The id of the client.
+ * @param batch The batch of the current poll round.
+ */
+void GFServer::_readClient(const unsigned long& id, std::vector<Job>& batch)
+{
+    Client& client = _clients[id];
+    char buffer[SERVER_READ_SIZE];
+    while (true)
+    {
+        ssize_t got = read(client.fd, buffer, SERVER_READ_SIZE);
+        if (got < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (got < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+        {
+            break;
+        }
+        if (got <= 0)
+        {
+            client.closing = true;
+            break;
+        }
+        client.input.append(buffer, got);
+        size_t start = 0;
+        size_t end;
+        while ((end = client.input.find('\n', start)) != std::string::npos)
+        {
+            batch.push_back({id, client.nextSeq++, client.input.substr(start, end - start), ""});
+            start = end + 1;
+        }
+        client.input.erase(0, start);
+        if (client.input.size() > SERVER_MAX_LINE)
+        {
+            client.input.clear();
+            client.closing = true;
+            break;
+        }
+    }
+}
+
+/**
+ * Sends as much of the given client's answers as the socket accepts.
+ * @param id The id of the client.
+ */
+void GFServer::_writeClient(const unsigned long& id)
+{
+    Client& client = _clients[id];
+    while (!client.output.empty())
+    {
+        ssize_t done = send(client.fd, client.output.data(), client.output.size(), MSG_NOSIGNAL);
+        if (done < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (done < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+        {
+            return;
+        }
+        if (done < 0)
+        {
+            client.output.clear();
+            client.closing = true;
+            return;
+        }
+        client.output.erase(0, done);
+    }
+}
+
+/**
+ * Moves the answered jobs into their clients' output, in the order of their requests.
+ */
+void GFServer::_collectDone()
+{
+    std::vector<Job> done;
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        done.swap(_done);
+    }
+    for (Job& job : done)
+    {
+        std::map<unsigned long, Client>::iterator found = _clients.find(job.client);
+        if (found == _clients.end())
+        {
+            continue;
+        }
+        Client& client = found->second;
+        client.ready[job.seq] = std::move(job.answer);
+        std::map<unsigned long, std::string>::iterator next;
+        while ((next = client.ready.find(client.nextToSend)) != client.ready.end())
+        {
+            client.output += next->second;
+            client.output += '\n';
+            client.ready.erase(next);
+            client.nextToSend++;
+        }
+    }
+}
+
+/**
+ * Connects a client to the server that listens on the given socket.
+ * @param path The path of the Unix domain socket.
+ * @return The connected socket, or -1 if the connection failed.
+ */
+int GFServer::connectTo(const std::string& path)
+{
+    struct sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path))
+    {
+        return -1;
+    }
+    std::strcpy(address.sun_path, path.c_str());
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd >= 0 && connect(fd, (struct sockaddr *) &address, sizeof(address)) != 0)
+    {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/**
+ * Binds the socket and serves the clients until stop is called. A closing client is polled only
+ * while it has answers to send, since a closed socket reports POLLHUP on every poll - its later
+ * answers wake the loop through the wake pipe.
+ * @return true if the server stopped normally, false if the socket couldn't be bound.
+ */
+bool GFServer::run()
+{
+    struct sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    if (_wakePipe[0] < 0 || _path.size() >= sizeof(address.sun_path))
+    {
+        return false;
+    }
+    std::strcpy(address.sun_path, _path.c_str());
+    _listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    unlink(_path.c_str());
+    if (_listenFd < 0 || bind(_listenFd, (struct sockaddr *) &address, sizeof(address)) != 0 ||
+        listen(_listenFd, SERVER_BACKLOG) != 0)
+    {
+        return false;
+    }
+    setNonBlocking(_listenFd);
+    for (std::thread& worker : _workers)
+    {
+        worker = std::thread(&GFServer::_workerLoop, this);
+    }
+    std::vector<struct pollfd> polled;
+    std::vector<unsigned long> ids;
+    bool running = true;
+    while (running)
+    {
+        polled.assign({{_wakePipe[0], POLLIN, 0}, {_listenFd, POLLIN, 0}});
+        ids.clear();
+        for (std::pair<const unsigned long, Client>& client : _clients)
+        {
+            short events = client.second.closing ? 0 : POLLIN;
+            events |= client.second.output.empty() ? 0 : POLLOUT;
+            if (events == 0)
+            {
+                continue;
+            }
+            polled.push_back({client.second.fd, events, 0});
+            ids.push_back(client.first);
+        }
+        if (poll(polled.data(), polled.size(), -1) < 0 && errno != EINTR)
+        {
+            break;
+        }
+        char wake;
+        while (read(_wakePipe[0], &wake, 1) == 1)
+        {
+            running = running && wake != WAKE_STOP;
+        }
+        int fd;
+        while ((polled[1].revents & POLLIN) && (fd = accept(_listenFd, nullptr, nullptr)) >= 0)
+        {
+            setNonBlocking(fd);
+            _clients[_nextClientId++].fd = fd;
+        }
+        std::vector<Job> batch;
+        for (size_t i = 0; i < ids.size(); i++)
+        {
+            if (polled[i + 2].revents & (POLLIN | POLLHUP | POLLERR))
+            {
+                _readClient(ids[i], batch);
+            }
+        }
+        if (!batch.empty())
+        {
+            std::lock_guard<std::mutex> guard(_lock);
+            for (size_t i = 0; i < batch.size(); i += SERVER_MAX_BATCH)
+            {
+                size_t end = std::min(batch.size(), i + SERVER_MAX_BATCH);
+                _pending.emplace_back(std::make_move_iterator(batch.begin() + i),
+                                      std::make_move_iterator(batch.begin() + end));
+            }
+        }
+        _hasWork.notify_all();
+        _collectDone();
+        for (std::map<unsigned long, Client>::iterator it = _clients.begin(); it != _clients.end();)
+        {
+            _writeClient(it->first);
+            Client& client = it->second;
+            if (client.closing && client.output.empty() && client.nextToSend == client.nextSeq)
+            {
+                close(client.fd);
+                it = _clients.erase(it);
+            }
+            else
+            {
+                it++;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * Makes run return, safe to call from a signal handler.
+ */
+void GFServer::stop()
+{
+    ssize_t done = write(_wakePipe[1], &WAKE_STOP, 1);
+    (void) done;
+}
@@ -0,0 +1,134 @@
+#ifndef EX1_GFSERVER_H
+#define EX1_GFSERVER_H
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "GFNumber.h"
+
+/**
+ * GFServer class, that listens on a Unix domain socket and answers pipelined requests, one per
+ * line, with the same text the main program prints:
+ * "add|sub|mul|mod n1 p l n2 p l" - answered with "n GF(p**l)".
+ * "factor n p l" - answered with "n=p1*p2*...*pk".
+ * Invalid requests are answered with "error". The answers of every client are sent in the order
+ * of its requests, while the requests of all the clients are batched onto a pool of workers.
+ */
+class GFServer
+{
+private:
+    /**
+     * A single request and its answer.
+     */
+    struct Job
+    {
+        unsigned long client;
+        unsigned long seq;
+        std::string line;
+        std::string answer;
+    };
+
+    /**
+     * The state of a connected client.
+     */
+    struct Client
+    {
+        int fd;
+        std::string input;
+        std::string output;
+        unsigned long nextSeq = 0;
+        unsigned long nextToSend = 0;
+        std::map<unsigned long, std::string> ready;
+        bool closing = false;
+    };
+
+    std::string _path;
+    int _listenFd;
+    int _wakePipe[2];
+    std::vector<std::thread> _workers;
+    std::map<unsigned long, Client> _clients;
+    unsigned long _nextClientId;
+    std::deque<std::vector<Job>> _pending;
+    std::vector<Job> _done;
+    std::mutex _lock;
+    std::condition_variable _hasWork;
+    bool _stopping;
+
+    /**
+     * Takes batches of jobs from the queue and answers them, until the server stops.
+     */
+    void _workerLoop();
+
+    /**
+     * Reads everything the given client sent, and adds its complete lines to the batch. A client
+     * whose incomplete line is too long is dropped.
+     * @param id The id of the client.
+     * @param batch The batch of the current poll round.
+     */
+    void _readClient(const unsigned long& id, std::vector<Job>& batch);
+
+    /**
+     * Sends as much of the given client's answers as the socket accepts.
+     * @param id The id of the client.
+     */
+    void _writeClient(const unsigned long& id);
+
+    /**
+     * Moves the answered jobs into their clients' output, in the order of their requests.
+     */
+    void _collectDone();
+
+public:
+    /**
+     * Constructor that gets two arguments.
+     * @param path The path of the Unix domain socket.
+     * @param workers The amount of worker threads.
+     */
+    GFServer(const std::string& path, const int& workers);
+
+    /**
+     * The server owns its sockets and threads, so it can't be copied.
+     */
+    GFServer(const GFServer& other) = delete;
+
+    /**
+     * Destructor for the GFServer object, stops the workers and removes the socket.
+     */
+    ~GFServer();
+
+    /**
+     * The server owns its sockets and threads, so it can't be assigned.
+     */
+    GFServer& operator=(const GFServer& other) = delete;
+
+    /**
+     * Answers a single request line.
+     * @param line The request, without the new line.
+     * @return The answer, without the new line.
+     */
+    static std::string answer(const std::string& line);
+
+    /**
+     * Connects a client to the server that listens on the given socket.
+     * @param path The path of the Unix domain socket.
+     * @return The connected socket, or -1 if the connection failed.
+     */
+    static int connectTo(const std::string& path);
+
+    /**
+     * Binds the socket and serves the clients until stop is called.
+     * @return true if the server stopped normally, false if the socket couldn't be bound.
+     */
+    bool run();
+
+    /**
+     * Makes run return, safe to call from a signal handler.
+     */
+    void stop();
+};
+
+#endif //EX1_GFSERVER_H
@@ -0,0 +1,738 @@
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <thread>
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+#include "GFSieve.h"
+
+/**
+ * Defines the amount of numbers in a segment - its odd numbers take 32 KB of bits.
+ */
+const long SEGMENT_NUMBERS = 1L << 19;
+
+/**
+ * Defines the largest square root of the range end that the sieve is used for.
+ */
+const long SIEVE_MAX_ROOT = 1L << 24;
+
+/**
+ * Defines how many numbers of the range every odd prime up to the square root must cover for the
+ * sieve to be used - narrower ranges are tested by Miller-Rabin.
+ */
+const long SIEVE_MIN_DENSITY = 8;
+
+/**
+ * Defines the bases that make Miller-Rabin deterministic for every 64 bit number.
+ */
+const long MILLER_RABIN_BASES[] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37};
+
+/**
+ * Defines the amount of bits in a word of a segment.
+ */
+const long WORD_BITS = 64;
+
+/**
+ * Defines the smallest number that isn't divisible by MILLER_RABIN_BASES and isn't prime - the
+ * square of the next prime.
+ */
+const long MILLER_RABIN_MIN_COMPOSITE = 41 * 41;
+
+/**
+ * Defines the bases that make Miller-Rabin deterministic below 3.8 * 10**18, so for every number
+ * of the 52 bit lanes.
+ */
+const uint64_t LANES52_BASES[] = {2, 3, 5, 7, 11, 13, 17, 19, 23};
+
+/**
+ * Defines the bases that make Miller-Rabin deterministic below 4.7 * 10**9, so for every number
+ * of the 32 bit lanes.
+ */
+const uint64_t LANES32_BASES[] = {2, 7, 61};
+
+/**
+ * Defines a prime that fills the unused lanes of the last group of a batch.
+ */
+const uint64_t LANE_PADDING = 1000003;
+
+/**
+ * Defines the amount of odd numbers of a segment that are collected and tested in one batch.
+ */
+const long SEGMENT_BATCH = 256;
+
+/**
+ * The Montgomery constants of one Miller-Rabin candidate.
+ */
+struct LaneConstants
+{
+    uint64_t nInverse, one, r2, minusOne, d, s;
+};
+
+/**
+ * Finds the Montgomery constants of a candidate, for R = 2**bits.
+ * @param n The odd candidate, smaller than R.
+ * @param bits The amount of bits of a lane.
+ * @return The constants - -n**(-1) modulo R, R and R**2 modulo n, -R modulo n, and n - 1 = d * 2**s.
+ */
+static LaneConstants laneConstants(const uint64_t& n, const int& bits)
+{
+    uint64_t inverse = n;
+    for (int i = 0; i < 5; i++)
+    {
+        inverse *= 2 - n * inverse;
+    }
+    uint64_t mask = (bits == 64) ? ~(uint64_t) 0 : ((uint64_t) 1 << bits) - 1;
+    LaneConstants res;
+    res.nInverse = (0 - inverse) & mask;
+    res.one = (uint64_t) (((unsigned __int128) 1 << bits) % n);
+    res.r2 = (uint64_t) (((unsigned __int128) 1 << (2 * bits)) % n);
+    res.minusOne = n - res.one;
+    res.s = __builtin_ctzll(n - 1);
+    res.d = (n - 1) >> res.s;
+    return res;
+}
+
+#if defined(__x86_64__)
+/**
+ * Multiplies 8 residues in Montgomery form with R = 2**52, by the 52 bit multiply-add
+ * instructions - the products are split into their low and high 52 bits, and since the low halves
+ * of a * b and m * n add up to 0 modulo R, only their carry is needed.
+ * @param a The first residues.
+ * @param b The second residues.
+ * @param n The odd moduli, smaller than 2**52.
+ * @param nInverse -n**(-1) modulo 2**52.
+ * @return a * b * R**(-1) modulo n.
+ */
+__attribute__((target("avx512f,avx512ifma")))
+static inline __m512i montgomery52(const __m512i& a, const __m512i& b, const __m512i& n,
+                                   const __m512i& nInverse)
+{
+    __m512i zero = _mm512_setzero_si512();
+    __m512i low = _mm512_madd52lo_epu64(zero, a, b);
+    __m512i high = _mm512_madd52hi_epu64(zero, a, b);
+    __m512i m = _mm512_madd52lo_epu64(zero, low, nInverse);
+    high = _mm512_madd52hi_epu64(high, m, n);
+    high = _mm512_mask_add_epi64(high, _mm512_cmpneq_epu64_mask(low, zero), high,
+                                 _mm512_set1_epi64(1));
+    return _mm512_mask_sub_epi64(high, _mm512_cmpge_epu64_mask(high, n), high, n);
+}
+
+/**
+ * Tests 8 candidates by Miller-Rabin at once, one candidate per 52 bit lane. A lane stops
+ * squaring as soon as it finds -1, and the test stops as soon as every lane is composite.
+ * @param nums The odd candidates, smaller than 2**52 and not divisible by MILLER_RABIN_BASES.
+ * @param res The array to put in whether every candidate is prime.
+ */
+__attribute__((target("avx512f,avx512ifma")))
+static void millerRabinLanes52(const uint64_t *nums, bool *res)
+{
+    alignas(64) uint64_t nInverse[8], one[8], r2[8], minusOne[8], d[8], s[8];
+    uint64_t maxS = 0;
+    for (int i = 0; i < 8; i++)
+    {
+        LaneConstants c = laneConstants(nums[i], 52);
+        nInverse[i] = c.nInverse;
+        one[i] = c.one;
+        r2[i] = c.r2;
+        minusOne[i] = c.minusOne;
+        d[i] = c.d;
+        s[i] = c.s;
+        maxS = std::max(maxS, c.s);
+    }
+    __m512i n = _mm512_loadu_si512(nums), inv = _mm512_load_si512(nInverse);
+    __m512i oneV = _mm512_load_si512(one), r2V = _mm512_load_si512(r2);
+    __m512i minusOneV = _mm512_load_si512(minusOne), dV = _mm512_load_si512(d);
+    __m512i sV = _mm512_load_si512(s);
+    __mmask8 alive = 0xFF;
+    for (const uint64_t& base : LANES52_BASES)
+    {
+        __m512i x = oneV;
+        __m512i power = montgomery52(_mm512_set1_epi64((long long) base), r2V, n, inv);
+        for (int bit = 0; bit < 52; bit++)
+        {
+            __mmask8 set = _mm512_test_epi64_mask(dV, _mm512_set1_epi64(1LL << bit));
+            x = _mm512_mask_mov_epi64(x, set, montgomery52(x, power, n, inv));
+            power = montgomery52(power, power, n, inv);
+        }
+        __mmask8 passed = _mm512_cmpeq_epu64_mask(x, oneV) | _mm512_cmpeq_epu64_mask(x, minusOneV);
+        for (uint64_t r = 1; r < maxS; r++)
+        {
+            __mmask8 active = alive & ~passed &
+                              _mm512_cmplt_epu64_mask(_mm512_set1_epi64((long long) r), sV);
+            if (active == 0)
+            {
+                break;
+            }
+            x = montgomery52(x, x, n, inv);
+            passed |= active & _mm512_cmpeq_epu64_mask(x, minusOneV);
+        }
+        alive &= passed;
+        if (alive == 0)
+        {
+            break;
+        }
+    }
+    for (int i = 0; i < 8; i++)
+    {
+        res[i] = (alive >> i) & 1;
+    }
+}
+
+/**
+ * Multiplies 4 residues in Montgomery form with R = 2**32, by 32x32 -> 64 bit multiplications.
+ * The sum a * b + m * n may not fit in 64 bits, so its halves are added separately - its low half
+ * is 0 modulo R, so it only carries 1 when the low half of a * b isn't 0.
+ * @param a The first residues.
+ * @param b The second residues.
+ * @param n The odd moduli, smaller than 2**32.
+ * @param nInverse -n**(-1) modulo 2**32.
+ * @return a * b * R**(-1) modulo n.
+ */
+__attribute__((target("avx2")))
+static inline __m256i montgomery32(const __m256i& a, const __m256i& b, const __m256i& n,
+                                   const __m256i& nInverse)
+{
+    __m256i zero = _mm256_setzero_si256();
+    __m256i product = _mm256_mul_epu32(a, b);
+    __m256i m = _mm256_mul_epu32(product, nInverse);
+    __m256i mn = _mm256_mul_epu32(m, n);
+    __m256i lowZero = _mm256_cmpeq_epi32(_mm256_blend_epi32(product, zero, 0xAA), zero);
+    __m256i carry = _mm256_andnot_si256(lowZero, _mm256_set1_epi64x(1));
+    __m256i res = _mm256_add_epi64(_mm256_add_epi64(_mm256_srli_epi64(product, 32),
+                                                    _mm256_srli_epi64(mn, 32)), carry);
+    __m256i less = _mm256_cmpgt_epi64(n, res);
+    return _mm256_sub_epi64(res, _mm256_andnot_si256(less, n));
+}
+
+/**
+ * @param a The first residues.
+ * @param b The second residues.
+ * @return A bit for every lane, set if the lanes are equal.
+ */
+__attribute__((target("avx2")))
+static inline int equalLanes(const __m256i& a, const __m256i& b)
+{
+    return _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(a, b)));
+}
+
+/**
+ * Tests 4 candidates by Miller-Rabin at once, one candidate per 32 bit lane. A lane stops
+ * squaring as soon as it finds -1, and the test stops as soon as every lane is composite.
+ * @param nums The odd candidates, smaller than 2**32 and not divisible by MILLER_RABIN_BASES.
+ * @param res The array to put in whether every candidate is prime.
+ */
+__attribute__((target("avx2")))
+static void millerRabinLanes32(const uint64_t *nums, bool *res)
+{
+    alignas(32) uint64_t nInverse[4], one[4], r2[4], minusOne[4], d[4], s[4];
+    uint64_t maxS = 0;
+    for (int i = 0; i < 4; i++)
+    {
+        LaneConstants c = laneConstants(nums[i], 32);
+        nInverse[i] = c.nInverse;
+        one[i] = c.one;
+        r2[i] = c.r2;
+        minusOne[i] = c.minusOne;
+        d[i] = c.d;
+        s[i] = c.s;
+        maxS = std::max(maxS, c.s);
+    }
+    __m256i n = _mm256_loadu_si256((const __m256i *) nums);
+    __m256i inv = _mm256_load_si256((const __m256i *) nInverse);
+    __m256i oneV = _mm256_load_si256((const __m256i *) one);
+    __m256i r2V = _mm256_load_si256((const __m256i *) r2);
+    __m256i minusOneV = _mm256_load_si256((const __m256i *) minusOne);
+    __m256i dV = _mm256_load_si256((const __m256i *) d);
+    __m256i sV = _mm256_load_si256((const __m256i *) s);
+    int alive = 0xF;
+    for (const uint64_t& base : LANES32_BASES)
+    {
+        __m256i x = oneV;
+        __m256i power = montgomery32(_mm256_set1_epi64x((long long) base), r2V, n, inv);
+        for (int bit = 0; bit < 32; bit++)
+        {
+            __m256i mask = _mm256_set1_epi64x(1LL << bit);
+            __m256i set = _mm256_cmpeq_epi64(_mm256_and_si256(dV, mask), mask);
+            x = _mm256_blendv_epi8(x, montgomery32(x, power, n, inv), set);
+            power = montgomery32(power, power, n, inv);
+        }
+        int passed = equalLanes(x, oneV) | equalLanes(x, minusOneV);
+        for (uint64_t r = 1; r < maxS; r++)
+        {
+            int below = _mm256_movemask_pd(_mm256_castsi256_pd(
+                    _mm256_cmpgt_epi64(sV, _mm256_set1_epi64x((long long) r))));
+            int active = alive & ~passed & below;
+            if (active == 0)
+            {
+                break;
+            }
+            x = montgomery32(x, x, n, inv);
+            passed |= active & equalLanes(x, minusOneV);
+        }
+        alive &= passed;
+        if (alive == 0)
+        {
+            break;
+        }
+    }
+    for (int i = 0; i < 4; i++)
+    {
+        res[i] = (alive >> i) & 1;
+    }
+}
+
+/**
+ * @return true if the processor has the 52 bit multiply-add instructions, false otherwise.
+ */
+static bool detectIfma()
+{
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512ifma");
+}
+
+/**
+ * @return true if the processor has the 256 bit integer instructions, false otherwise.
+ */
+static bool detectAvx2()
+{
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+}
+
+/**
+ * Defines if the processor has the 52 bit multiply-add instructions.
+ */
+static const bool HAS_IFMA = detectIfma();
+
+/**
+ * Defines if the processor has the 256 bit integer instructions.
+ */
+static const bool HAS_AVX2 = detectAvx2();
+#endif
+
+/**
+ * Calculates the product of two residues modulo m, without overflowing.
+ * @param a The first residue.
+ * @param b The second residue.
+ * @param m The modulo.
+ * @return a * b modulo m.
+ */
+static inline unsigned long mulMod(const unsigned long& a, const unsigned long& b,
+                                   const unsigned long& m)
+{
+    return (unsigned long) ((unsigned __int128) a * b % m);
+}
+
+/**
+ * Checks if the given number is prime by the Miller-Rabin test, with the bases that make it
+ * deterministic for every 64 bit number - n - 1 = d * 2**s, and for every base a, a**d must be 1
+ * or one of its s squarings must be n - 1.
+ * @param n The number to check.
+ * @return true if n is prime, false otherwise.
+ */
+bool GFSieve::millerRabin(const long& n)
+{
+    if (n < 2)
+    {
+        return false;
+    }
+    for (const long& base : MILLER_RABIN_BASES)
+    {
+        if (n % base == 0)
+        {
+            return n == base;
+        }
+    }
+    unsigned long d = n - 1;
+    int s = 0;
+    while (d % 2 == 0)
+    {
+        d /= 2;
+        s++;
+    }
+    for (const long& base : MILLER_RABIN_BASES)
+    {
+        unsigned long x = 1, a = base;
+        for (unsigned long e = d; e > 0; e >>= 1)
+        {
+            if (e & 1)
+            {
+                x = mulMod(x, a, n);
+            }
+            a = mulMod(a, a, n);
+        }
+        if (x == 1 || x == (unsigned long) n - 1)
+        {
+            continue;
+        }
+        bool composite = true;
+        for (int i = 1; composite && i < s; i++)
+        {
+            x = mulMod(x, x, n);
+            composite = x != (unsigned long) n - 1;
+        }
+        if (composite)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Tests many numbers at once by Miller-Rabin. The numbers that are small or divisible by one of
+ * the bases are decided on the spot, and the rest are gathered into groups that are tested in
+ * SIMD lanes - 8 lanes of 52 bits by the multiply-add instructions when the processor has them,
+ * or 4 lanes of 32 bits by 32x32 -> 64 bit multiplications. The numbers that don't fit in a lane,
+ * or every number when the processor has neither, are tested one by one.
+ * @param nums The numbers to check.
+ * @param len The amount of numbers.
+ * @param res The array to put in whether every number is prime.
+ */
+void GFSieve::millerRabinBatch(const long *nums, const long& len, bool *res)
+{
+    int lanes = 0;
+    uint64_t limit = 0;
+#if defined(__x86_64__)
+    if (HAS_IFMA)
+    {
+        lanes = 8;
+        limit = (uint64_t) 1 << 52;
+    }
+    else if (HAS_AVX2)
+    {
+        lanes = 4;
+        limit = (uint64_t) 1 << 32;
+    }
+#endif
+    std::vector<uint64_t> candidates;
+    std::vector<long> indices;
+    for (long i = 0; i < len; i++)
+    {
+        long n = nums[i];
+        if (n < MILLER_RABIN_MIN_COMPOSITE || (uint64_t) n >= limit)
+        {
+            res[i] = millerRabin(n);
+            continue;
+        }
+        res[i] = true;
+        for (const long& base : MILLER_RABIN_BASES)
+        {
+            if (n % base == 0)
+            {
+                res[i] = false;
+                break;
+            }
+        }
+        if (res[i])
+        {
+            candidates.push_back(n);
+            indices.push_back(i);
+        }
+    }
+#if defined(__x86_64__)
+    for (size_t first = 0; first < candidates.size(); first += lanes)
+    {
+        uint64_t group[8];
+        bool prime[8];
+        for (int j = 0; j < lanes; j++)
+        {
+            group[j] = (first + j < candidates.size()) ? candidates[first + j] : LANE_PADDING;
+        }
+        if (lanes == 8)
+        {
+            millerRabinLanes52(group, prime);
+        }
+        else
+        {
+            millerRabinLanes32(group, prime);
+        }
+        for (int j = 0; j < lanes && first + j < candidates.size(); j++)
+        {
+            res[indices[first + j]] = prime[j];
+        }
+    }
+#endif
+}
+
+/**
+ * Finds the odd primes up to the given limit, by a sieve of the odd numbers.
+ * @param limit The largest number to check.
+ * @return The odd primes, in increasing order.
+ */
+std::vector<long> GFSieve::_basePrimes(const long& limit)
+{
+    std::vector<long> primes;
+    if (limit < 3)
+    {
+        return primes;
+    }
+    std::vector<bool> composite((limit - 1) / 2, false);
+    for (long i = 0; i < (long) composite.size(); i++)
+    {
+        if (composite[i])
+        {
+            continue;
+        }
+        long p = 2 * i + 3;
+        primes.push_back(p);
+        for (long m = p * p; m <= limit; m += 2 * p)
+        {
+            composite[(m - 3) / 2] = true;
+        }
+    }
+    return primes;
+}
+
+/**
+ * Sieves the odd numbers of one segment - every odd prime crosses out its odd multiples from its
+ * square, which are p apart in the bits.
+ * @param segLo The first number of the segment.
+ * @param segHi The last number of the segment.
+ * @param primes The odd primes up to the square root of segHi at least.
+ * @param odd The bits of the odd numbers of the segment.
+ */
+void GFSieve::_sieveSegment(const long& segLo, const long& segHi, const std::vector<long>& primes,
+                            std::vector<uint64_t>& odd)
+{
+    long first = segLo | 1;
+    if (segHi < first)
+    {
+        return;
+    }
+    unsigned long last = (segHi - first) / 2;
+    uint64_t *bits = odd.data();
+    for (const long& p : primes)
+    {
+        if (p * p > segHi)
+        {
+            break;
+        }
+        long start = std::max(p * p, (first + p - 1) / p * p);
+        if (start % 2 == 0)
+        {
+            start += p;
+        }
+        for (unsigned long i = (start - first) / 2; i <= last; i += p)
+        {
+            bits[i / WORD_BITS] &= ~((uint64_t) 1 << (i % WORD_BITS));
+        }
+    }
+    if (first == 1)
+    {
+        bits[0] &= ~(uint64_t) 1;
+    }
+}
+
+/**
+ * Tests the odd numbers of one segment by Miller-Rabin, SEGMENT_BATCH numbers at a time.
+ * @param segLo The first number of the segment.
+ * @param segHi The last number of the segment.
+ * @param odd The bits of the odd numbers of the segment.
+ */
+void GFSieve::_testSegment(const long& segLo, const long& segHi, std::vector<uint64_t>& odd)
+{
+    long first = segLo | 1;
+    long count = (segHi >= first) ? (segHi - first) / 2 + 1 : 0;
+    long nums[SEGMENT_BATCH];
+    bool prime[SEGMENT_BATCH];
+    for (long start = 0; start < count; start += SEGMENT_BATCH)
+    {
+        long len = std::min(SEGMENT_BATCH, count - start);
+        for (long j = 0; j < len; j++)
+        {
+            nums[j] = first + 2 * (start + j);
+        }
+        millerRabinBatch(nums, len, prime);
+        for (long j = 0; j < len; j++)
+        {
+            if (!prime[j])
+            {
+                long i = start + j;
+                odd[i / WORD_BITS] &= ~((uint64_t) 1 << (i % WORD_BITS));
+            }
+        }
+    }
+}
+
+/**
+ * Finds the primes of every segment of the range, by the sieve or by Miller-Rabin, and gives
+ * them to the given function. The segments are split between the hardware threads, so the
+ * function may be called from several threads at once.
+ * @param lo The first number of the range, not negative.
+ * @param hi The last number of the range.
+ * @param func The function to call with every segment.
+ * @return The amount of segments.
+ */
+long GFSieve::_forEachSegment(const long& lo, const long& hi, const SegmentFunction& func)
+{
+    assert(lo >= 0 && lo <= hi);
+    long root = (long) std::sqrt((long double) hi);
+    while (root * root > hi)
+    {
+        root--;
+    }
+    while ((unsigned long) (root + 1) * (root + 1) <= (unsigned long) hi)
+    {
+        root++;
+    }
+    bool sieve = root <= SIEVE_MAX_ROOT && (hi - lo) / SIEVE_MIN_DENSITY >= root / 2;
+    std::vector<long> primes = sieve ? _basePrimes(root) : std::vector<long>();
+    long segments = (hi - lo) / SEGMENT_NUMBERS + 1;
+    std::atomic<long> next(0);
+    auto work = [&]()
+    {
+        std::vector<uint64_t> odd;
+        for (long k = next++; k < segments; k = next++)
+        {
+            long segLo = lo + k * SEGMENT_NUMBERS;
+            long segHi = (k + 1 == segments) ? hi : segLo + SEGMENT_NUMBERS - 1;
+            long first = segLo | 1;
+            long count = (segHi >= first) ? (segHi - first) / 2 + 1 : 0;
+            odd.assign((count + WORD_BITS - 1) / WORD_BITS, ~(uint64_t) 0);
+            if (count % WORD_BITS != 0)
+            {
+                odd.back() = ((uint64_t) 1 << (count % WORD_BITS)) - 1;
+            }
+            if (sieve)
+            {
+                _sieveSegment(segLo, segHi, primes, odd);
+            }
+            else
+            {
+                _testSegment(segLo, segHi, odd);
+            }
+            func(k, segLo, segHi, odd);
+        }
+    };
+    long threads = std::min((long) std::thread::hardware_concurrency(), segments);
+    std::vector<std::thread> workers;
+    for (long i = 1; i < threads; i++)
+    {
+        workers.emplace_back(work);
+    }
+    work();
+    for (std::thread& worker : workers)
+    {
+        worker.join();
+    }
+    return segments;
+}
+
+/**
+ * Gives the primes of the range to the given function one segment at a time, so the primes of
+ * the whole range are never kept at once. The function may be called from several threads at
+ * once, and the segments come in any order. 2 is even, so it's never in a segment.
+ * @param lo The first number of the range.
+ * @param hi The last number of the range.
+ * @param func The function to call with every segment.
+ * @return The amount of segments.
+ */
+long GFSieve::forEachSegment(long lo, const long& hi, const SegmentFunction& func)
+{
+    lo = std::max(lo, 0L);
+    if (lo > hi)
+    {
+        return 0;
+    }
+    return _forEachSegment(lo, hi, func);
+}
+
+/**
+ * @param lo The first number of the range.
+ * @param hi The last number of the range.
+ * @return The primes in [lo, hi], in increasing order.
+ */
+std::vector<long> GFSieve::primesInRange(long lo, const long& hi)
+{
+    lo = std::max(lo, 0L);
+    std::vector<long> res;
+    if (lo > hi)
+    {
+        return res;
+    }
+    if (lo <= 2 && hi >= 2)
+    {
+        res.push_back(2);
+    }
+    std::vector<std::vector<long>> found((hi - lo) / SEGMENT_NUMBERS + 1);
+    _forEachSegment(lo, hi, [&found](const long& k, const long& segLo, const long&,
+                                     const std::vector<uint64_t>& odd)
+    {
+        long first = segLo | 1;
+        for (size_t w = 0; w < odd.size(); w++)
+        {
+            for (uint64_t bits = odd[w]; bits != 0; bits &= bits - 1)
+            {
+                found[k].push_back(first + 2 * ((long) w * WORD_BITS + __builtin_ctzll(bits)));
+            }
+        }
+    });
+    for (const std::vector<long>& segment : found)
+    {
+        res.insert(res.end(), segment.begin(), segment.end());
+    }
+    return res;
+}
+
+/**
+ * @param lo The first number of the range.
+ * @param hi The last number of the range.
+ * @return The amount of primes in [lo, hi].
+ */
+long GFSieve::countPrimes(long lo, const long& hi)
+{
+    lo = std::max(lo, 0L);
+    if (lo > hi)
+    {
+        return 0;
+    }
+    std::atomic<long> count((lo <= 2 && hi >= 2) ? 1 : 0);
+    _forEachSegment(lo, hi, [&count](const long&, const long&, const long&,
+                                     const std::vector<uint64_t>& odd)
+    {
+        long segmentCount = 0;
+        for (const uint64_t& word : odd)
+        {
+            segmentCount += __builtin_popcountll(word);
+        }
+        count += segmentCount;
+    });
+    return count;
+}
+
+/**
+ * @param lo The first number of the range, not negative.
+ * @param hi The last number of the range.
+ * @return A bit for every number in [lo, hi] - bit i % 64 of word i / 64 is set if lo + i is
+ * prime.
+ */
+std::vector<uint64_t> GFSieve::primeBitmap(const long& lo, const long& hi)
+{
+    assert(lo >= 0);
+    if (lo > hi)
+    {
+        return std::vector<uint64_t>();
+    }
+    std::vector<uint64_t> res((hi - lo) / WORD_BITS + 1, 0);
+    if (lo <= 2 && hi >= 2)
+    {
+        res[0] |= (uint64_t) 1 << (2 - lo);
+    }
+    _forEachSegment(lo, hi, [&res, &lo](const long&, const long& segLo, const long&,
+                                        const std::vector<uint64_t>& odd)
+    {
+        long first = segLo | 1;
+        for (size_t w = 0; w < odd.size(); w++)
+        {
+            for (uint64_t bits = odd[w]; bits != 0; bits &= bits - 1)
+            {
+                long i = first + 2 * ((long) w * WORD_BITS + __builtin_ctzll(bits)) - lo;
+                res[i / WORD_BITS] |= (uint64_t) 1 << (i % WORD_BITS);
+            }
+        }
+    });
+    return res;
+}
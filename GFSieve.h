@@ -0,0 +1,114 @@
+#ifndef EX1_GFSIEVE_H
+#define EX1_GFSIEVE_H
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/**
+ * GFSieve class, primality of every number in a range.
+ * The range is split into segments of 2**19 numbers, whose odd numbers are kept as 32 KB of bits so
+ * a segment fits in the L1 cache, and the segments are sieved in parallel by the odd primes up to
+ * the square root of the range end. Ranges that are too high and narrow for a sieve to pay off are
+ * tested number by number with a deterministic Miller-Rabin test instead.
+ */
+class GFSieve
+{
+public:
+    /**
+     * The function that gets every segment - its index, its first and last numbers, and a bit for
+     * every odd number in it (bit i is the i-th odd number from the first one), set if it's prime.
+     */
+    typedef std::function<void(const long&, const long&, const long&,
+                               const std::vector<uint64_t>&)> SegmentFunction;
+
+private:
+    /**
+     * Finds the odd primes up to the given limit, by a sieve of the odd numbers.
+     * @param limit The largest number to check.
+     * @return The odd primes, in increasing order.
+     */
+    static std::vector<long> _basePrimes(const long& limit);
+
+    /**
+     * Sieves the odd numbers of one segment.
+     * @param segLo The first number of the segment.
+     * @param segHi The last number of the segment.
+     * @param primes The odd primes up to the square root of segHi at least.
+     * @param odd The bits of the odd numbers of the segment.
+     */
+    static void _sieveSegment(const long& segLo, const long& segHi,
+                              const std::vector<long>& primes, std::vector<uint64_t>& odd);
+
+    /**
+     * Tests the odd numbers of one segment by Miller-Rabin.
+     * @param segLo The first number of the segment.
+     * @param segHi The last number of the segment.
+     * @param odd The bits of the odd numbers of the segment.
+     */
+    static void _testSegment(const long& segLo, const long& segHi, std::vector<uint64_t>& odd);
+
+    /**
+     * Finds the primes of every segment of the range, by the sieve or by Miller-Rabin, and gives
+     * them to the given function. The segments are split between the hardware threads, so the
+     * function may be called from several threads at once.
+     * @param lo The first number of the range, not negative.
+     * @param hi The last number of the range.
+     * @param func The function to call with every segment.
+     * @return The amount of segments.
+     */
+    static long _forEachSegment(const long& lo, const long& hi, const SegmentFunction& func);
+
+public:
+    /**
+     * Checks if the given number is prime by the Miller-Rabin test, with the bases that make it
+     * deterministic for every 64 bit number.
+     * @param n The number to check.
+     * @return true if n is prime, false otherwise.
+     */
+    static bool millerRabin(const long& n);
+
+    /**
+     * Tests many numbers at once by Miller-Rabin, several numbers in the SIMD lanes of the
+     * processor when it has them, and one by one otherwise.
+     * @param nums The numbers to check.
+     * @param len The amount of numbers.
+     * @param res The array to put in whether every number is prime.
+     */
+    static void millerRabinBatch(const long *nums, const long& len, bool *res);
+
+    /**
+     * Gives the primes of the range to the given function one segment at a time, so the primes of
+     * the whole range are never kept at once. The function may be called from several threads at
+     * once, and the segments come in any order. 2 is even, so it's never in a segment.
+     * @param lo The first number of the range.
+     * @param hi The last number of the range.
+     * @param func The function to call with every segment.
+     * @return The amount of segments.
+     */
+    static long forEachSegment(long lo, const long& hi, const SegmentFunction& func);
+
+    /**
+     * @param lo The first number of the range.
+     * @param hi The last number of the range.
+     * @return The primes in [lo, hi], in increasing order.
+     */
+    static std::vector<long> primesInRange(long lo, const long& hi);
+
+    /**
+     * @param lo The first number of the range.
+     * @param hi The last number of the range.
+     * @return The amount of primes in [lo, hi].
+     */
+    static long countPrimes(long lo, const long& hi);
+
+    /**
+     * @param lo The first number of the range, not negative.
+     * @param hi The last number of the range.
+     * @return A bit for every number in [lo, hi] - bit i % 64 of word i / 64 is set if lo + i is
+     * prime.
+     */
+    static std::vector<uint64_t> primeBitmap(const long& lo, const long& hi);
+};
+
+#endif //EX1_GFSIEVE_H
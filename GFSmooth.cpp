@@ -0,0 +1,399 @@
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <functional>
+#include <thread>
+#include "GFSieve.h"
+#include "GFSmooth.h"
+
+/**
+ * Defines the amount of numbers in one product tree - a group is reduced by one pass over the
+ * primes, whose cost grows with the size of the root.
+ */
+const long SMOOTH_GROUP = 256;
+
+/**
+ * Defines the amount of squarings of the remainders, 2**6 = 64 is at least the exponent of any
+ * prime in a 64 bit number.
+ */
+const int SMOOTH_SQUARINGS = 6;
+
+/**
+ * Calculates the product of two residues modulo m, without overflowing.
+ * @param a The first residue.
+ * @param b The second residue.
+ * @param m The modulo.
+ * @return a * b modulo m.
+ */
+static inline unsigned long mulMod(const unsigned long& a, const unsigned long& b,
+                                   const unsigned long& m)
+{
+    return (unsigned long) ((unsigned __int128) a * b % m);
+}
+
+/**
+ * @param a The first number.
+ * @param b The second number.
+ * @return The greatest common divisor of the numbers.
+ */
+static unsigned long gcd(unsigned long a, unsigned long b)
+{
+    while (b != 0)
+    {
+        unsigned long temp = a % b;
+        a = b;
+        b = temp;
+    }
+    return a;
+}
+
+/**
+ * @param a The first integer.
+ * @param b The second integer.
+ * @return The product.
+ */
+GFSmooth::BigInt GFSmooth::_multiply(const BigInt& a, const BigInt& b)
+{
+    if (a.empty() || b.empty())
+    {
+        return BigInt();
+    }
+    BigInt res(a.size() + b.size(), 0);
+    for (size_t i = 0; i < a.size(); i++)
+    {
+        uint64_t carry = 0;
+        for (size_t j = 0; j < b.size(); j++)
+        {
+            unsigned __int128 cur = (unsigned __int128) a[i] * b[j] + res[i + j] + carry;
+            res[i + j] = (uint64_t) cur;
+            carry = (uint64_t) (cur >> 64);
+        }
+        res[i + b.size()] = carry;
+    }
+    while (!res.empty() && res.back() == 0)
+    {
+        res.pop_back();
+    }
+    return res;
+}
+
+/**
+ * Reduces an integer modulo a normalized one, by Knuth's long division - every limb of the
+ * quotient is estimated from the top limbs, the multiple of v is subtracted, and v is added back
+ * in the rare case that the estimate was one too big.
+ * @param u The integer to reduce, replaced by the remainder.
+ * @param v The non zero modulo, whose highest limb has its top bit set.
+ */
+void GFSmooth::_reduceNormalized(BigInt& u, const BigInt& v)
+{
+    size_t n = v.size();
+    if (u.size() < n)
+    {
+        return;
+    }
+    u.push_back(0);
+    for (size_t j = u.size() - n; j-- > 0;)
+    {
+        unsigned __int128 top = ((unsigned __int128) u[j + n] << 64) | u[j + n - 1];
+        unsigned __int128 qhat = top / v[n - 1], rhat = top % v[n - 1];
+        while ((qhat >> 64) != 0 ||
+               (n >= 2 && qhat * v[n - 2] > ((rhat << 64) | u[j + n - 2])))
+        {
+            qhat--;
+            rhat += v[n - 1];
+            if ((rhat >> 64) != 0)
+            {
+                break;
+            }
+        }
+        uint64_t carry = 0, borrow = 0;
+        for (size_t i = 0; i < n; i++)
+        {
+            unsigned __int128 product = qhat * v[i] + carry;
+            carry = (uint64_t) (product >> 64);
+            uint64_t low = (uint64_t) product;
+            uint64_t cur = u[i + j] - low - borrow;
+            borrow = (u[i + j] < low) || (u[i + j] - low < borrow);
+            u[i + j] = cur;
+        }
+        uint64_t cur = u[j + n] - carry - borrow;
+        bool negative = (u[j + n] < carry) || (u[j + n] - carry < borrow);
+        u[j + n] = cur;
+        if (negative)
+        {
+            carry = 0;
+            for (size_t i = 0; i < n; i++)
+            {
+                unsigned __int128 sum = (unsigned __int128) u[i + j] + v[i] + carry;
+                u[i + j] = (uint64_t) sum;
+                carry = (uint64_t) (sum >> 64);
+            }
+            u[j + n] += carry;
+        }
+    }
+    u.resize(n);
+    while (!u.empty() && u.back() == 0)
+    {
+        u.pop_back();
+    }
+}
+
+/**
+ * Reduces an integer by shifting both it and the modulo until the modulo is normalized.
+ * @param a The integer.
+ * @param m The non zero modulo.
+ * @return a modulo m.
+ */
+GFSmooth::BigInt GFSmooth::_remainder(const BigInt& a, const BigInt& m)
+{
+    assert(!m.empty());
+    int shift = __builtin_clzll(m.back());
+    BigInt u(a.size() + 1, 0), v(m.size(), 0);
+    for (size_t i = 0; i < m.size(); i++)
+    {
+        v[i] = (m[i] << shift) | ((shift > 0 && i > 0) ? m[i - 1] >> (64 - shift) : 0);
+    }
+    for (size_t i = 0; i <= a.size(); i++)
+    {
+        uint64_t low = (i < a.size()) ? a[i] << shift : 0;
+        u[i] = low | ((shift > 0 && i > 0) ? a[i - 1] >> (64 - shift) : 0);
+    }
+    while (!u.empty() && u.back() == 0)
+    {
+        u.pop_back();
+    }
+    _reduceNormalized(u, v);
+    BigInt res(u.size(), 0);
+    for (size_t i = 0; i < u.size(); i++)
+    {
+        res[i] = (u[i] >> shift) | ((shift > 0 && i + 1 < u.size()) ? u[i + 1] << (64 - shift) : 0);
+    }
+    while (!res.empty() && res.back() == 0)
+    {
+        res.pop_back();
+    }
+    return res;
+}
+
+/**
+ * Builds the product tree of a group of numbers from the leaves up, and starts its product of
+ * primes at 1. The product is kept shifted like the normalized root, since x * 2**s modulo
+ * m * 2**s is (x modulo m) * 2**s, so every step of _multiplyWords is a multiplication by one limb
+ * and one step of the long division.
+ * @param group The group.
+ * @param nums The numbers, bigger than 1.
+ * @param len The amount of numbers.
+ */
+void GFSmooth::_startGroup(Group& group, const long *nums, const long& len)
+{
+    std::vector<std::vector<BigInt>>& tree = group.tree;
+    tree.assign(1, std::vector<BigInt>());
+    for (long i = 0; i < len; i++)
+    {
+        tree[0].push_back(BigInt(1, (uint64_t) nums[i]));
+    }
+    while (tree.back().size() > 1)
+    {
+        const std::vector<BigInt>& level = tree.back();
+        std::vector<BigInt> next;
+        for (size_t i = 0; i < level.size(); i += 2)
+        {
+            next.push_back((i + 1 < level.size()) ? _multiply(level[i], level[i + 1]) : level[i]);
+        }
+        tree.push_back(next);
+    }
+    const BigInt& m = tree.back()[0];
+    group.root = m;
+    group.shift = __builtin_clzll(m.back());
+    if (group.shift > 0)
+    {
+        for (size_t i = m.size(); i-- > 0;)
+        {
+            group.root[i] = (m[i] << group.shift) | ((i > 0) ? m[i - 1] >> (64 - group.shift) : 0);
+        }
+    }
+    group.product = BigInt(1, (uint64_t) 1 << group.shift);
+    _reduceNormalized(group.product, group.root);
+}
+
+/**
+ * Multiplies the product of primes of a group by one word of primes at a time, and reduces it
+ * modulo the root after every word - the whole product of the primes is never built.
+ * @param group The group.
+ * @param words Primes, packed into words.
+ */
+void GFSmooth::_multiplyWords(Group& group, const std::vector<uint64_t>& words)
+{
+    for (const uint64_t& word : words)
+    {
+        uint64_t carry = 0;
+        for (uint64_t& limb : group.product)
+        {
+            unsigned __int128 cur = (unsigned __int128) limb * word + carry;
+            limb = (uint64_t) cur;
+            carry = (uint64_t) (cur >> 64);
+        }
+        if (carry != 0)
+        {
+            group.product.push_back(carry);
+        }
+        _reduceNormalized(group.product, group.root);
+    }
+}
+
+/**
+ * Finds the B-smooth parts of a group of numbers - the product of the primes is shifted back, and
+ * every node's remainder is reduced modulo its children. With r = P modulo n at a leaf, the smooth
+ * part of n is gcd(n, r**64 modulo n), since every prime up to B divides r and no other prime does.
+ * @param group The group, whose product has every prime up to B.
+ * @param nums The numbers, bigger than 1.
+ * @param len The amount of numbers.
+ * @param res The array to put the smooth parts in.
+ */
+void GFSmooth::_finishGroup(const Group& group, const long *nums, const long& len, long *res)
+{
+    const BigInt& acc = group.product;
+    const int& shift = group.shift;
+    BigInt product(acc.size(), 0);
+    for (size_t i = 0; i < acc.size(); i++)
+    {
+        product[i] = (acc[i] >> shift) |
+                     ((shift > 0 && i + 1 < acc.size()) ? acc[i + 1] << (64 - shift) : 0);
+    }
+    while (!product.empty() && product.back() == 0)
+    {
+        product.pop_back();
+    }
+    const std::vector<std::vector<BigInt>>& tree = group.tree;
+    std::vector<BigInt> remainders = {product};
+    for (size_t d = tree.size() - 1; d-- > 0;)
+    {
+        std::vector<BigInt> next(tree[d].size());
+        for (size_t i = 0; i < tree[d].size(); i++)
+        {
+            next[i] = _remainder(remainders[i / 2], tree[d][i]);
+        }
+        remainders.swap(next);
+    }
+    for (long i = 0; i < len; i++)
+    {
+        unsigned long n = nums[i];
+        unsigned long r = remainders[i].empty() ? 0 : remainders[i][0];
+        for (int j = 0; j < SMOOTH_SQUARINGS; j++)
+        {
+            r = mulMod(r, r, n);
+        }
+        res[i] = (long) gcd(n, r);
+    }
+}
+
+/**
+ * @param n The number, not negative.
+ * @param bound The bound B.
+ * @return The largest divisor of n whose prime factors are at most B, 0 if n is 0.
+ */
+long GFSmooth::smoothPart(const long& n, const long& bound)
+{
+    long res;
+    smoothParts(&n, 1, bound, &res);
+    return res;
+}
+
+/**
+ * Finds the B-smooth parts of many numbers at once. A prime above the largest number divides
+ * none of them, so B is clamped to it. The numbers are split into groups, every group with its own
+ * product tree, and the sieve hands out the primes one segment at a time - every segment packs
+ * its primes into as few words as their products fit in, and multiplies them into the product of
+ * every group. The groups are built and finished in parallel, and the segments are sieved in
+ * parallel.
+ * @param nums The numbers, not negative.
+ * @param len The amount of numbers.
+ * @param bound The bound B.
+ * @param res The array to put the smooth parts in, 0 for every 0.
+ */
+void GFSmooth::smoothParts(const long *nums, const long& len, const long& bound, long *res)
+{
+    std::vector<long> numbers, indices;
+    long largest = 0;
+    for (long i = 0; i < len; i++)
+    {
+        assert(nums[i] >= 0);
+        res[i] = (nums[i] <= 1 || bound < 2) ? std::min(nums[i], 1L) : 0;
+        if (nums[i] > 1 && bound >= 2)
+        {
+            numbers.push_back(nums[i]);
+            indices.push_back(i);
+            largest = std::max(largest, nums[i]);
+        }
+    }
+    if (numbers.empty())
+    {
+        return;
+    }
+    long limit = std::min(bound, largest);
+    long groupsCount = ((long) numbers.size() + SMOOTH_GROUP - 1) / SMOOTH_GROUP;
+    std::vector<Group> groups(groupsCount);
+    std::vector<long> parts(numbers.size());
+    auto forEachGroup = [&](const std::function<void(const long&, const long&, const long&)>& func)
+    {
+        std::atomic<long> next(0);
+        auto work = [&]()
+        {
+            for (long k = next++; k < groupsCount; k = next++)
+            {
+                long first = k * SMOOTH_GROUP;
+                func(k, first, std::min(SMOOTH_GROUP, (long) numbers.size() - first));
+            }
+        };
+        long threads = std::min((long) std::thread::hardware_concurrency(), groupsCount);
+        std::vector<std::thread> workers;
+        for (long i = 1; i < threads; i++)
+        {
+            workers.emplace_back(work);
+        }
+        work();
+        for (std::thread& worker : workers)
+        {
+            worker.join();
+        }
+    };
+    forEachGroup([&](const long& k, const long& first, const long& count)
+    {
+        _startGroup(groups[k], numbers.data() + first, count);
+        _multiplyWords(groups[k], std::vector<uint64_t>(1, 2));
+    });
+    GFSieve::forEachSegment(3, limit, [&groups](const long&, const long& segLo, const long&,
+                                                const std::vector<uint64_t>& odd)
+    {
+        std::vector<uint64_t> words;
+        uint64_t word = 1;
+        long first = segLo | 1;
+        for (size_t w = 0; w < odd.size(); w++)
+        {
+            for (uint64_t bits = odd[w]; bits != 0; bits &= bits - 1)
+            {
+                uint64_t p = first + 2 * ((long) w * 64 + __builtin_ctzll(bits));
+                if (word > UINT64_MAX / p)
+                {
+                    words.push_back(word);
+                    word = 1;
+                }
+                word *= p;
+            }
+        }
+        words.push_back(word);
+        for (Group& group : groups)
+        {
+            std::lock_guard<std::mutex> guard(group.lock);
+            _multiplyWords(group, words);
+        }
+    });
+    forEachGroup([&](const long& k, const long& first, const long& count)
+    {
+        _finishGroup(groups[k], numbers.data() + first, count, parts.data() + first);
+    });
+    for (size_t i = 0; i < numbers.size(); i++)
+    {
+        res[indices[i]] = parts[i];
+    }
+}
@@ -0,0 +1,102 @@
+#ifndef EX1_GFSMOOTH_H
+#define EX1_GFSMOOTH_H
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+/**
+ * GFSmooth class, the B-smooth parts of numbers - the largest divisors whose prime factors are all
+ * at most B - by Bernstein's batch method. The numbers are multiplied together in a product tree,
+ * the product of the primes up to B is reduced modulo the root, and the remainders are passed down
+ * the tree to every number. No number is divided by the primes one by one.
+ * Groups of numbers get their own trees, which are split between the hardware threads. The primes
+ * come from the sieve one segment at a time and are multiplied into every root right away, so they
+ * are never kept all at once.
+ */
+class GFSmooth
+{
+private:
+    /**
+     * A non negative integer of any size, its 64 bit limbs from the lowest one up, without zero
+     * limbs on top (0 has no limbs).
+     */
+    typedef std::vector<uint64_t> BigInt;
+
+    /**
+     * A group of numbers - its product tree, its root normalized (shifted until its top bit is
+     * set), and the product of the primes so far modulo the root, kept shifted like it.
+     */
+    struct Group
+    {
+        std::vector<std::vector<BigInt>> tree;
+        BigInt root, product;
+        int shift;
+        std::mutex lock;
+    };
+
+    /**
+     * @param a The first integer.
+     * @param b The second integer.
+     * @return The product.
+     */
+    static BigInt _multiply(const BigInt& a, const BigInt& b);
+
+    /**
+     * Reduces an integer modulo a normalized one, by Knuth's long division.
+     * @param u The integer to reduce, replaced by the remainder.
+     * @param v The non zero modulo, whose highest limb has its top bit set.
+     */
+    static void _reduceNormalized(BigInt& u, const BigInt& v);
+
+    /**
+     * @param a The integer.
+     * @param m The non zero modulo.
+     * @return a modulo m.
+     */
+    static BigInt _remainder(const BigInt& a, const BigInt& m);
+
+    /**
+     * Builds the product tree of a group of numbers, and starts its product of primes at 1.
+     * @param group The group.
+     * @param nums The numbers, bigger than 1.
+     * @param len The amount of numbers.
+     */
+    static void _startGroup(Group& group, const long *nums, const long& len);
+
+    /**
+     * Multiplies the product of primes of a group by one word of primes at a time.
+     * @param group The group.
+     * @param words Primes, packed into words.
+     */
+    static void _multiplyWords(Group& group, const std::vector<uint64_t>& words);
+
+    /**
+     * Finds the B-smooth parts of a group of numbers, by passing its product of primes down the
+     * remainder tree.
+     * @param group The group, whose product has every prime up to B.
+     * @param nums The numbers, bigger than 1.
+     * @param len The amount of numbers.
+     * @param res The array to put the smooth parts in.
+     */
+    static void _finishGroup(const Group& group, const long *nums, const long& len, long *res);
+
+public:
+    /**
+     * @param n The number, not negative.
+     * @param bound The bound B.
+     * @return The largest divisor of n whose prime factors are at most B, 0 if n is 0.
+     */
+    static long smoothPart(const long& n, const long& bound);
+
+    /**
+     * Finds the B-smooth parts of many numbers at once.
+     * @param nums The numbers, not negative.
+     * @param len The amount of numbers.
+     * @param bound The bound B.
+     * @param res The array to put the smooth parts in, 0 for every 0.
+     */
+    static void smoothParts(const long *nums, const long& len, const long& bound, long *res);
+};
+
+#endif //EX1_GFSMOOTH_H
@@ -0,0 +1,266 @@
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include "GFStats.h"
+
+/**
+ * Defines the names of the counters, in the order of GFCounter.
+ */
+const char *const COUNTER_NAMES[] = {"rho_iterations", "rho_restarts", "gcd_calls",
+                                     "trial_candidates", "primality_tests", "array_resizes",
+                                     "cache_hits"};
+
+/**
+ * Defines the names of the timers, in the order of GFTimer.
+ */
+const char *const TIMER_NAMES[] = {"factorization", "pollard_rho", "trial_division"};
+
+/**
+ * The counters and timers of a single thread. Only the owner thread writes them, so relaxed
+ * loads and stores are enough, while a snapshot may read them from any thread.
+ */
+struct StatsBlock
+{
+    std::atomic<long> counters[(int) GFCounter::COUNT] = {};
+    std::atomic<long> times[(int) GFTimer::COUNT] = {};
+    std::atomic<long> calls[(int) GFTimer::COUNT] = {};
+};
+
+/**
+ * The blocks of all the running threads, and the sums of the finished ones.
+ */
+struct StatsRegistry
+{
+    std::mutex lock;
+    std::vector<StatsBlock *> blocks;
+    long counters[(int) GFCounter::COUNT] = {};
+    long times[(int) GFTimer::COUNT] = {};
+    long calls[(int) GFTimer::COUNT] = {};
+};
+
+/**
+ * @return The registry of all the threads.
+ */
+static StatsRegistry& registry()
+{
+    static StatsRegistry instance;
+    return instance;
+}
+
+/**
+ * Adds the given value to a block entry, which only the calling thread writes.
+ * @param entry The entry to add to.
+ * @param amount The amount to add.
+ */
+static inline void addRelaxed(std::atomic<long>& entry, const long& amount)
+{
+    entry.store(entry.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+/**
+ * Adds the values of the given block to the given arrays.
+ * @param block The block to add.
+ * @param counters The counters to add to.
+ * @param times The timers total time to add to.
+ * @param calls The timers calls to add to.
+ */
+static void addBlock(const StatsBlock& block, long *counters, long *times, long *calls)
+{
+    for (int i = 0; i < (int) GFCounter::COUNT; i++)
+    {
+        counters[i] += block.counters[i].load(std::memory_order_relaxed);
+    }
+    for (int i = 0; i < (int) GFTimer::COUNT; i++)
+    {
+        times[i] += block.times[i].load(std::memory_order_relaxed);
+        calls[i] += block.calls[i].load(std::memory_order_relaxed);
+    }
+}
+
+/**
+ * StatsOwner class, that registers the block of a thread, and adds it to the retired sums when
+ * the thread finishes.
+ */
+class StatsOwner
+{
+public:
+    StatsBlock block;
+
+    /**
+     * Default constructor - registers the block.
+     */
+    StatsOwner()
+    {
+        StatsRegistry& stats = registry();
+        std::lock_guard<std::mutex> guard(stats.lock);
+        stats.blocks.push_back(&block);
+    }
+
+    /**
+     * Destructor for the StatsOwner object, moves the block into the retired sums.
+     */
+    ~StatsOwner()
+    {
+        StatsRegistry& stats = registry();
+        std::lock_guard<std::mutex> guard(stats.lock);
+        for (size_t i = 0; i < stats.blocks.size(); i++)
+        {
+            if (stats.blocks[i] == &block)
+            {
+                stats.blocks.erase(stats.blocks.begin() + i);
+                break;
+            }
+        }
+        addBlock(block, stats.counters, stats.times, stats.calls);
+    }
+};
+
+/**
+ * @return The block of the calling thread.
+ */
+static StatsBlock& localBlock()
+{
+    thread_local StatsOwner owner;
+    return owner.block;
+}
+
+/**
+ * Default constructor - creates an empty snapshot.
+ */
+GFStats::GFStats() : _counters(), _times(), _calls() {}
+
+/**
+ * @return true if the library was built with GF_ENABLE_STATS, false otherwise.
+ */
+bool GFStats::isEnabled()
+{
+#ifdef GF_ENABLE_STATS
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * Adds the given amount to the calling thread's counter.
+ * @param counter The counter to add to.
+ * @param amount The amount to add.
+ */
+void GFStats::count(const GFCounter& counter, const long& amount)
+{
+    addRelaxed(localBlock().counters[(int) counter], amount);
+}
+
+/**
+ * Adds a timed call to the calling thread's timer.
+ * @param timer The timer to add to.
+ * @param ns The duration of the call in nanoseconds.
+ */
+void GFStats::time(const GFTimer& timer, const long& ns)
+{
+    StatsBlock& block = localBlock();
+    addRelaxed(block.times[(int) timer], ns);
+    addRelaxed(block.calls[(int) timer], 1);
+}
+
+/**
+ * @return The sum of the counters and timers of all the threads, including finished ones.
+ */
+GFStats GFStats::snapshot()
+{
+    StatsRegistry& stats = registry();
+    std::lock_guard<std::mutex> guard(stats.lock);
+    GFStats res;
+    for (int i = 0; i < (int) GFCounter::COUNT; i++)
+    {
+        res._counters[i] = stats.counters[i];
+    }
+    for (int i = 0; i < (int) GFTimer::COUNT; i++)
+    {
+        res._times[i] = stats.times[i];
+        res._calls[i] = stats.calls[i];
+    }
+    for (const StatsBlock *block : stats.blocks)
+    {
+        addBlock(*block, res._counters, res._times, res._calls);
+    }
+    return res;
+}
+
+/**
+ * Zeroes the counters and timers of all the threads.
+ * Updates that other threads make while the reset runs may survive it.
+ */
+void GFStats::reset()
+{
+    StatsRegistry& stats = registry();
+    std::lock_guard<std::mutex> guard(stats.lock);
+    for (int i = 0; i < (int) GFCounter::COUNT; i++)
+    {
+        stats.counters[i] = 0;
+    }
+    for (int i = 0; i < (int) GFTimer::COUNT; i++)
+    {
+        stats.times[i] = 0;
+        stats.calls[i] = 0;
+    }
+    for (StatsBlock *block : stats.blocks)
+    {
+        for (std::atomic<long>& entry : block->counters)
+        {
+            entry.store(0, std::memory_order_relaxed);
+        }
+        for (int i = 0; i < (int) GFTimer::COUNT; i++)
+        {
+            block->times[i].store(0, std::memory_order_relaxed);
+            block->calls[i].store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+/**
+ * @param counter The counter to get.
+ * @return The value of the counter.
+ */
+long GFStats::getCount(const GFCounter& counter) const
+{
+    return _counters[(int) counter];
+}
+
+/**
+ * @param timer The timer to get.
+ * @return The total time of the timer in nanoseconds.
+ */
+long GFStats::getTime(const GFTimer& timer) const
+{
+    return _times[(int) timer];
+}
+
+/**
+ * @param timer The timer to get.
+ * @return The amount of timed calls of the timer.
+ */
+long GFStats::getCalls(const GFTimer& timer) const
+{
+    return _calls[(int) timer];
+}
+
+/**
+ * Prints the snapshot to the given stream, one "name value" per line.
+ * @param s Out stream to print to.
+ * @param obj Object to print.
+ * @return The given out stream.
+ */
+std::ostream& operator<<(std::ostream& s, const GFStats& obj)
+{
+    for (int i = 0; i < (int) GFCounter::COUNT; i++)
+    {
+        s << COUNTER_NAMES[i] << " " << obj._counters[i] << std::endl;
+    }
+    for (int i = 0; i < (int) GFTimer::COUNT; i++)
+    {
+        s << TIMER_NAMES[i] << "_calls " << obj._calls[i] << std::endl;
+        s << TIMER_NAMES[i] << "_ns " << obj._times[i] << std::endl;
+    }
+    return s;
+}
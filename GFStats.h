@@ -0,0 +1,142 @@
+#ifndef EX1_GFSTATS_H
+#define EX1_GFSTATS_H
+
+#include <chrono>
+#include <iostream>
+
+/**
+ * The counted events of the factorization engine.
+ */
+enum class GFCounter
+{
+    RHO_ITERATIONS,
+    RHO_RESTARTS,
+    GCD_CALLS,
+    TRIAL_CANDIDATES,
+    PRIMALITY_TESTS,
+    ARRAY_RESIZES,
+    CACHE_HITS,
+    COUNT
+};
+
+/**
+ * The timed stages of the factorization engine.
+ */
+enum class GFTimer
+{
+    FACTORIZATION,
+    POLLARD_RHO,
+    TRIAL_DIVISION,
+    COUNT
+};
+
+/**
+ * GFStats class, a snapshot of the counters and timers of all the threads.
+ * Every thread updates its own counters without locking, and they are summed only when a snapshot
+ * is taken. When GF_ENABLE_STATS isn't defined the GF_STATS_* macros expand to nothing, so the
+ * instrumented code pays nothing and every snapshot is empty.
+ */
+class GFStats
+{
+private:
+    long _counters[(int) GFCounter::COUNT];
+    long _times[(int) GFTimer::COUNT];
+    long _calls[(int) GFTimer::COUNT];
+
+public:
+    /**
+     * Default constructor - creates an empty snapshot.
+     */
+    GFStats();
+
+    /**
+     * @return true if the library was built with GF_ENABLE_STATS, false otherwise.
+     */
+    static bool isEnabled();
+
+    /**
+     * Adds the given amount to the calling thread's counter.
+     * @param counter The counter to add to.
+     * @param amount The amount to add.
+     */
+    static void count(const GFCounter& counter, const long& amount);
+
+    /**
+     * Adds a timed call to the calling thread's timer.
+     * @param timer The timer to add to.
+     * @param ns The duration of the call in nanoseconds.
+     */
+    static void time(const GFTimer& timer, const long& ns);
+
+    /**
+     * @return The sum of the counters and timers of all the threads, including finished ones.
+     */
+    static GFStats snapshot();
+
+    /**
+     * Zeroes the counters and timers of all the threads.
+     */
+    static void reset();
+
+    /**
+     * @param counter The counter to get.
+     * @return The value of the counter.
+     */
+    long getCount(const GFCounter& counter) const;
+
+    /**
+     * @param timer The timer to get.
+     * @return The total time of the timer in nanoseconds.
+     */
+    long getTime(const GFTimer& timer) const;
+
+    /**
+     * @param timer The timer to get.
+     * @return The amount of timed calls of the timer.
+     */
+    long getCalls(const GFTimer& timer) const;
+
+    /**
+     * Prints the snapshot to the given stream, one "name value" per line.
+     * @param s Out stream to print to.
+     * @param obj Object to print.
+     * @return The given out stream.
+     */
+    friend std::ostream& operator<<(std::ostream& s, const GFStats& obj);
+};
+
+/**
+ * GFStatsTimer class, that adds the time from its construction to its destruction to a timer.
+ */
+class GFStatsTimer
+{
+private:
+    GFTimer _timer;
+    std::chrono::steady_clock::time_point _start;
+
+public:
+    /**
+     * Constructor that starts timing.
+     * @param timer The timer to add the time to.
+     */
+    GFStatsTimer(const GFTimer& timer) : _timer(timer), _start(std::chrono::steady_clock::now()) {}
+
+    /**
+     * Destructor for the GFStatsTimer object, adds the time to the timer.
+     */
+    ~GFStatsTimer()
+    {
+        std::chrono::nanoseconds took = std::chrono::steady_clock::now() - _start;
+        GFStats::time(_timer, took.count());
+    }
+};
+
+#ifdef GF_ENABLE_STATS
+#define GF_STATS_COUNT(counter, amount) GFStats::count(GFCounter::counter, (amount))
+#define GF_STATS_TIME(timer) GFStatsTimer statsTimer##timer(GFTimer::timer)
+#else
+#define GF_STATS_COUNT(counter, amount) ((void) 0)
+#define GF_STATS_TIME(timer) ((void) 0)
+#endif
+
+#endif //EX1_GFSTATS_H
@@ -0,0 +1,648 @@
+#ifndef EX1_GFUINT_H
+#define EX1_GFUINT_H
+
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+/**
+ * GFUInt class, an unsigned integer of a fixed amount of 64 bit limbs (LIMBS * 64 bits), with the
+ * wrap around arithmetic of the built in unsigned types - so the wide number templates can use it
+ * exactly like unsigned long and unsigned __int128.
+ * The limbs are kept from the lowest one up.
+ */
+template <int LIMBS>
+class GFUInt
+{
+private:
+    uint64_t _limbs[LIMBS];
+
+    /**
+     * Divides by a divisor of one limb.
+     * @param d The non zero divisor.
+     * @param rem Reference to the remainder.
+     * @return The quotient.
+     */
+    GFUInt _divideSmall(const uint64_t& d, uint64_t& rem) const
+    {
+        GFUInt res;
+        unsigned __int128 cur = 0;
+        for (int i = LIMBS - 1; i >= 0; i--)
+        {
+            cur = (cur << 64) | _limbs[i];
+            res._limbs[i] = (uint64_t) (cur / d);
+            cur %= d;
+        }
+        rem = (uint64_t) cur;
+        return res;
+    }
+
+    /**
+     * Divides two numbers by shifting and subtracting, one bit of the quotient at a time.
+     * @param a The dividend.
+     * @param b The non zero divisor.
+     * @param quotient Reference to the quotient.
+     * @param remainder Reference to the remainder.
+     */
+    static void _divide(const GFUInt& a, const GFUInt& b, GFUInt& quotient, GFUInt& remainder)
+    {
+        assert(!b.isZero());
+        if (b.bitLength() <= 64)
+        {
+            uint64_t rem = 0;
+            quotient = a._divideSmall(b._limbs[0], rem);
+            remainder = GFUInt(rem);
+            return;
+        }
+        quotient = GFUInt();
+        remainder = GFUInt();
+        for (int i = a.bitLength() - 1; i >= 0; i--)
+        {
+            bool carry = remainder._limbs[LIMBS - 1] >> 63;
+            remainder = (remainder << 1) | GFUInt((a._limbs[i / 64] >> (i % 64)) & 1);
+            if (carry || remainder >= b)
+            {
+                remainder -= b;
+                quotient._limbs[i / 64] |= (uint64_t) 1 << (i % 64);
+            }
+        }
+    }
+
+public:
+    /**
+     * Constructor that gets the value of the lowest limb.
+     * @param v The value.
+     */
+    GFUInt(const unsigned long& v = 0)
+    {
+        _limbs[0] = v;
+        for (int i = 1; i < LIMBS; i++)
+        {
+            _limbs[i] = 0;
+        }
+    }
+
+    /**
+     * @param i The index of the limb, from the lowest one.
+     * @return The limb.
+     */
+    const uint64_t& getLimb(const int& i) const
+    {
+        return _limbs[i];
+    }
+
+    /**
+     * @param i The index of the limb, from the lowest one.
+     * @param v The value to put in the limb.
+     */
+    void setLimb(const int& i, const uint64_t& v)
+    {
+        _limbs[i] = v;
+    }
+
+    /**
+     * @return true if the number is 0, false otherwise.
+     */
+    bool isZero() const
+    {
+        for (int i = 0; i < LIMBS; i++)
+        {
+            if (_limbs[i] != 0)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @return The amount of bits up to the highest set one, 0 for the number 0.
+     */
+    int bitLength() const
+    {
+        for (int i = LIMBS - 1; i >= 0; i--)
+        {
+            if (_limbs[i] != 0)
+            {
+                return 64 * i + 64 - __builtin_clzll(_limbs[i]);
+            }
+        }
+        return 0;
+    }
+
+    /**
+     * Multiplies two numbers without losing the high half of the product.
+     * @param a The first number.
+     * @param b The second number.
+     * @param lo Reference to the low LIMBS limbs of the product.
+     * @param hi Reference to the high LIMBS limbs of the product.
+     */
+    static void multiplyWide(const GFUInt& a, const GFUInt& b, GFUInt& lo, GFUInt& hi)
+    {
+        uint64_t res[2 * LIMBS] = {0};
+        for (int i = 0; i < LIMBS; i++)
+        {
+            uint64_t carry = 0;
+            for (int j = 0; j < LIMBS; j++)
+            {
+                unsigned __int128 cur = (unsigned __int128) a._limbs[i] * b._limbs[j] +
+                                        res[i + j] + carry;
+                res[i + j] = (uint64_t) cur;
+                carry = (uint64_t) (cur >> 64);
+            }
+            res[i + LIMBS] = carry;
+        }
+        for (int i = 0; i < LIMBS; i++)
+        {
+            lo._limbs[i] = res[i];
+            hi._limbs[i] = res[i + LIMBS];
+        }
+    }
+
+    /**
+     * @param other The number to add.
+     * @return The sum, modulo 2**(64 * LIMBS).
+     */
+    GFUInt operator+(const GFUInt& other) const
+    {
+        GFUInt res;
+        uint64_t carry = 0;
+        for (int i = 0; i < LIMBS; i++)
+        {
+            unsigned __int128 cur = (unsigned __int128) _limbs[i] + other._limbs[i] + carry;
+            res._limbs[i] = (uint64_t) cur;
+            carry = (uint64_t) (cur >> 64);
+        }
+        return res;
+    }
+
+    /**
+     * @param other The number to subtract.
+     * @return The difference, modulo 2**(64 * LIMBS).
+     */
+    GFUInt operator-(const GFUInt& other) const
+    {
+        GFUInt res;
+        uint64_t borrow = 0;
+        for (int i = 0; i < LIMBS; i++)
+        {
+            uint64_t cur = _limbs[i] - other._limbs[i] - borrow;
+            borrow = (_limbs[i] < other._limbs[i]) || (_limbs[i] - other._limbs[i] < borrow);
+            res._limbs[i] = cur;
+        }
+        return res;
+    }
+
+    /**
+     * @param other The number to multiply by.
+     * @return The product, modulo 2**(64 * LIMBS).
+     */
+    GFUInt operator*(const GFUInt& other) const
+    {
+        GFUInt res;
+        for (int i = 0; i < LIMBS; i++)
+        {
+            uint64_t carry = 0;
+            for (int j = 0; i + j < LIMBS; j++)
+            {
+                unsigned __int128 cur = (unsigned __int128) _limbs[i] * other._limbs[j] +
+                                        res._limbs[i + j] + carry;
+                res._limbs[i + j] = (uint64_t) cur;
+                carry = (uint64_t) (cur >> 64);
+            }
+        }
+        return res;
+    }
+
+    /**
+     * @param other The non zero number to divide by.
+     * @return The quotient, rounded down.
+     */
+    GFUInt operator/(const GFUInt& other) const
+    {
+        GFUInt quotient, remainder;
+        _divide(*this, other, quotient, remainder);
+        return quotient;
+    }
+
+    /**
+     * @param other The non zero number to divide by.
+     * @return The remainder of the division.
+     */
+    GFUInt operator%(const GFUInt& other) const
+    {
+        GFUInt quotient, remainder;
+        _divide(*this, other, quotient, remainder);
+        return remainder;
+    }
+
+    /**
+     * @param s The amount of bits to shift by.
+     * @return The number shifted to the left, the high bits are lost.
+     */
+    GFUInt operator<<(const int& s) const
+    {
+        GFUInt res;
+        int limbs = s / 64, bits = s % 64;
+        for (int i = LIMBS - 1; i >= limbs; i--)
+        {
+            res._limbs[i] = _limbs[i - limbs] << bits;
+            if (bits > 0 && i - limbs > 0)
+            {
+                res._limbs[i] |= _limbs[i - limbs - 1] >> (64 - bits);
+            }
+        }
+        return res;
+    }
+
+    /**
+     * @param s The amount of bits to shift by.
+     * @return The number shifted to the right.
+     */
+    GFUInt operator>>(const int& s) const
+    {
+        GFUInt res;
+        int limbs = s / 64, bits = s % 64;
+        for (int i = 0; i + limbs < LIMBS; i++)
+        {
+            res._limbs[i] = _limbs[i + limbs] >> bits;
+            if (bits > 0 && i + limbs + 1 < LIMBS)
+            {
+                res._limbs[i] |= _limbs[i + limbs + 1] << (64 - bits);
+            }
+        }
+        return res;
+    }
+
+    /**
+     * @param other The number to and with.
+     * @return The bitwise and of the numbers.
+     */
+    GFUInt operator&(const GFUInt& other) const
+    {
+        GFUInt res;
+        for (int i = 0; i < LIMBS; i++)
+        {
+            res._limbs[i] = _limbs[i] & other._limbs[i];
+        }
+        return res;
+    }
+
+    /**
+     * @param other The number to or with.
+     * @return The bitwise or of the numbers.
+     */
+    GFUInt operator|(const GFUInt& other) const
+    {
+        GFUInt res;
+        for (int i = 0; i < LIMBS; i++)
+        {
+            res._limbs[i] = _limbs[i] | other._limbs[i];
+        }
+        return res;
+    }
+
+    /**
+     * @param other The number to add.
+     * @return This after the addition.
+     */
+    GFUInt& operator+=(const GFUInt& other)
+    {
+        return *this = *this + other;
+    }
+
+    /**
+     * @param other The number to subtract.
+     * @return This after the subtraction.
+     */
+    GFUInt& operator-=(const GFUInt& other)
+    {
+        return *this = *this - other;
+    }
+
+    /**
+     * @param other The number to multiply by.
+     * @return This after the multiplication.
+     */
+    GFUInt& operator*=(const GFUInt& other)
+    {
+        return *this = *this * other;
+    }
+
+    /**
+     * @param other The number to divide by.
+     * @return This after the division.
+     */
+    GFUInt& operator/=(const GFUInt& other)
+    {
+        return *this = *this / other;
+    }
+
+    /**
+     * @param other The number to divide by.
+     * @return This after the modulo operation.
+     */
+    GFUInt& operator%=(const GFUInt& other)
+    {
+        return *this = *this % other;
+    }
+
+    /**
+     * @param s The amount of bits to shift by.
+     * @return This after the shift.
+     */
+    GFUInt& operator>>=(const int& s)
+    {
+        return *this = *this >> s;
+    }
+
+    /**
+     * @param s The amount of bits to shift by.
+     * @return This after the shift.
+     */
+    GFUInt& operator<<=(const int& s)
+    {
+        return *this = *this << s;
+    }
+
+    /**
+     * @param other Reference to another GFUInt object.
+     * @return true if all the limbs are equal, false otherwise.
+     */
+    bool operator==(const GFUInt& other) const
+    {
+        for (int i = 0; i < LIMBS; i++)
+        {
+            if (_limbs[i] != other._limbs[i])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @param other Reference to another GFUInt object.
+     * @return true if some limbs are different, false otherwise.
+     */
+    bool operator!=(const GFUInt& other) const
+    {
+        return !(*this == other);
+    }
+
+    /**
+     * @param other Reference to another GFUInt object.
+     * @return true if this number is smaller than the other, false otherwise.
+     */
+    bool operator<(const GFUInt& other) const
+    {
+        for (int i = LIMBS - 1; i >= 0; i--)
+        {
+            if (_limbs[i] != other._limbs[i])
+            {
+                return _limbs[i] < other._limbs[i];
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @param other Reference to another GFUInt object.
+     * @return true if this number is bigger than the other, false otherwise.
+     */
+    bool operator>(const GFUInt& other) const
+    {
+        return other < *this;
+    }
+
+    /**
+     * @param other Reference to another GFUInt object.
+     * @return true if this number is smaller or equal to the other, false otherwise.
+     */
+    bool operator<=(const GFUInt& other) const
+    {
+        return !(other < *this);
+    }
+
+    /**
+     * @param other Reference to another GFUInt object.
+     * @return true if this number is bigger or equal to the other, false otherwise.
+     */
+    bool operator>=(const GFUInt& other) const
+    {
+        return !(*this < other);
+    }
+};
+
+/**
+ * The properties of a backing integer of the wide numbers - its width, and its product in twice
+ * the width.
+ */
+template <typename Int>
+struct GFWideTraits;
+
+/**
+ * The properties of the 64 bit backing integer.
+ */
+template <>
+struct GFWideTraits<unsigned long>
+{
+    static const int BITS = 64;
+
+    /**
+     * @param a The first number.
+     * @param b The second number.
+     * @param lo Reference to the low half of the product.
+     * @param hi Reference to the high half of the product.
+     */
+    static void multiplyWide(const unsigned long& a, const unsigned long& b, unsigned long& lo,
+                             unsigned long& hi)
+    {
+        unsigned __int128 res = (unsigned __int128) a * b;
+        lo = (unsigned long) res;
+        hi = (unsigned long) (res >> 64);
+    }
+
+    /**
+     * @param a The number.
+     * @return The lowest 64 bits of the number.
+     */
+    static unsigned long low64(const unsigned long& a)
+    {
+        return a;
+    }
+};
+
+/**
+ * The properties of the 128 bit backing integer.
+ */
+template <>
+struct GFWideTraits<unsigned __int128>
+{
+    static const int BITS = 128;
+
+    /**
+     * @param a The first number.
+     * @param b The second number.
+     * @param lo Reference to the low half of the product.
+     * @param hi Reference to the high half of the product.
+     */
+    static void multiplyWide(const unsigned __int128& a, const unsigned __int128& b,
+                             unsigned __int128& lo, unsigned __int128& hi)
+    {
+        const unsigned __int128 MASK = ~(uint64_t) 0;
+        unsigned __int128 low = (a & MASK) * (b & MASK);
+        unsigned __int128 cross1 = (a >> 64) * (b & MASK);
+        unsigned __int128 cross2 = (a & MASK) * (b >> 64);
+        unsigned __int128 high = (a >> 64) * (b >> 64);
+        unsigned __int128 middle = (low >> 64) + (cross1 & MASK) + (cross2 & MASK);
+        lo = (middle << 64) | (low & MASK);
+        hi = high + (cross1 >> 64) + (cross2 >> 64) + (middle >> 64);
+    }
+
+    /**
+     * @param a The number.
+     * @return The lowest 64 bits of the number.
+     */
+    static unsigned long low64(const unsigned __int128& a)
+    {
+        return (unsigned long) a;
+    }
+};
+
+/**
+ * The properties of a multi limb backing integer.
+ */
+template <int LIMBS>
+struct GFWideTraits<GFUInt<LIMBS>>
+{
+    static const int BITS = 64 * LIMBS;
+
+    /**
+     * @param a The first number.
+     * @param b The second number.
+     * @param lo Reference to the low half of the product.
+     * @param hi Reference to the high half of the product.
+     */
+    static void multiplyWide(const GFUInt<LIMBS>& a, const GFUInt<LIMBS>& b, GFUInt<LIMBS>& lo,
+                             GFUInt<LIMBS>& hi)
+    {
+        GFUInt<LIMBS>::multiplyWide(a, b, lo, hi);
+    }
+
+    /**
+     * @param a The number.
+     * @return The lowest 64 bits of the number.
+     */
+    static unsigned long low64(const GFUInt<LIMBS>& a)
+    {
+        return a.getLimb(0);
+    }
+};
+
+/**
+ * Finds the greatest common divisor of two numbers by the binary gcd algorithm, which only
+ * shifts and subtracts, so it's fast for the multi limb numbers too.
+ * @param a The first number.
+ * @param b The second number.
+ * @return The greatest common divisor, 0 if both numbers are 0.
+ */
+template <typename Int>
+Int gfGcd(Int a, Int b)
+{
+    if (a == Int(0))
+    {
+        return b;
+    }
+    if (b == Int(0))
+    {
+        return a;
+    }
+    int shift = 0;
+    while (((a | b) & Int(1)) == Int(0))
+    {
+        a >>= 1;
+        b >>= 1;
+        shift++;
+    }
+    while ((a & Int(1)) == Int(0))
+    {
+        a >>= 1;
+    }
+    while (b != Int(0))
+    {
+        while ((b & Int(1)) == Int(0))
+        {
+            b >>= 1;
+        }
+        if (a > b)
+        {
+            Int temp = a;
+            a = b;
+            b = temp;
+        }
+        b -= a;
+    }
+    return a << shift;
+}
+
+/**
+ * @param n The number to convert.
+ * @return The decimal digits of the number.
+ */
+template <typename Int>
+std::string gfToString(Int n)
+{
+    const unsigned long CHUNK = 10000000000000000000UL;
+    if (n == Int(0))
+    {
+        return "0";
+    }
+    std::string res;
+    while (n != Int(0))
+    {
+        Int quotient = n / Int(CHUNK);
+        std::string digits = std::to_string(GFWideTraits<Int>::low64(n - quotient * Int(CHUNK)));
+        if (quotient != Int(0))
+        {
+            digits = std::string(19 - digits.size(), '0') + digits;
+        }
+        res = digits + res;
+        n = quotient;
+    }
+    return res;
+}
+
+/**
+ * Parses a number from its decimal digits.
+ * @param str The digits.
+ * @param n Reference to the parsed number.
+ * @return true if str is a non empty string of digits that fits in the type, false otherwise.
+ */
+template <typename Int>
+bool gfParse(const std::string& str, Int& n)
+{
+    const Int MAX = Int(0) - Int(1);
+    n = Int(0);
+    if (str.empty())
+    {
+        return false;
+    }
+    for (const char& c : str)
+    {
+        if (c < '0' || c > '9')
+        {
+            return false;
+        }
+        Int digit = Int((unsigned long) (c - '0'));
+        if (n > (MAX - digit) / Int(10))
+        {
+            return false;
+        }
+        n = n * Int(10) + digit;
+    }
+    return true;
+}
+
+#endif //EX1_GFUINT_H
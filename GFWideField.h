@@ -0,0 +1,213 @@
+#ifndef EX1_GFWIDEFIELD_H
+#define EX1_GFWIDEFIELD_H
+
+#include <climits>
+#include "GFMontgomery.h"
+#include "GFSieve.h"
+
+/**
+ * Defines the bases of the wide Miller-Rabin test - the first 13 primes make it deterministic
+ * below 3.3 * 10**24, and the rest make a wrong answer above it unlikely.
+ */
+const unsigned long WIDE_MILLER_RABIN_BASES[] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41,
+                                                 43, 47, 53, 59, 61, 67, 71, 73, 79, 83, 89};
+
+/**
+ * GFWideField class, a GField whose char and order are kept in a wider backing integer - Int,
+ * which is unsigned long, unsigned __int128 or GFUInt (256 or 512 bits).
+ * The order is found by exact integer multiplication, and the arithmetic modulo the order is done
+ * in Montgomery form (or by masking, when the char is 2).
+ */
+template <typename Int>
+class GFWideField
+{
+private:
+    Int _char;
+    long _deg;
+    Int _order;
+    bool _binary;
+    GFMontgomery<Int> _mont;
+
+public:
+    /**
+     * Constructor that gets two arguments.
+     * @param p The prime char.
+     * @param l The positive degree, p**l must fit in the backing integer.
+     */
+    GFWideField(const Int& p, const long& l) : _char(p), _deg(l), _order(1), _binary(p == Int(2))
+    {
+        assert(isPrime(p));
+        assert(l > 0);
+        for (long i = 0; i < l; i++)
+        {
+            assert(_order <= (Int(0) - Int(1)) / p);
+            _order *= p;
+        }
+        if (!_binary)
+        {
+            _mont = GFMontgomery<Int>(_order);
+        }
+    }
+
+    /**
+     * Constructor that gets only the char, and create a default l (1).
+     * @param p The prime char.
+     */
+    GFWideField(const Int& p) : GFWideField(p, 1)
+    {}
+
+    /**
+     * Default constructor.
+     * Will create a default p (2) and a default l (1);
+     */
+    GFWideField() : GFWideField(Int(2), 1)
+    {}
+
+    /**
+     * @return The char of the field.
+     */
+    const Int& getChar() const
+    {
+        return _char;
+    }
+
+    /**
+     * @return The degree of the field.
+     */
+    const long& getDegree() const
+    {
+        return _deg;
+    }
+
+    /**
+     * @return The order of the field - p**l.
+     */
+    const Int& getOrder() const
+    {
+        return _order;
+    }
+
+    /**
+     * @param a The first residue.
+     * @param b The second residue.
+     * @return The sum modulo the order.
+     */
+    Int add(const Int& a, const Int& b) const
+    {
+        if (_binary)
+        {
+            return (a + b) & (_order - Int(1));
+        }
+        return _mont.add(a, b);
+    }
+
+    /**
+     * @param a The first residue.
+     * @param b The second residue.
+     * @return The difference modulo the order.
+     */
+    Int subtract(const Int& a, const Int& b) const
+    {
+        if (_binary)
+        {
+            return (a - b) & (_order - Int(1));
+        }
+        return _mont.subtract(a, b);
+    }
+
+    /**
+     * @param a The first residue.
+     * @param b The second residue.
+     * @return The product modulo the order.
+     */
+    Int multiply(const Int& a, const Int& b) const
+    {
+        if (_binary)
+        {
+            return (a * b) & (_order - Int(1));
+        }
+        return _mont.multiplyPlain(a, b);
+    }
+
+    /**
+     * Checks if the given number is prime - by the 64 bit deterministic Miller-Rabin test when it
+     * fits, and otherwise by trial division of the small primes and a Miller-Rabin test in
+     * Montgomery form with WIDE_MILLER_RABIN_BASES.
+     * @param n The number to check.
+     * @return true if n is prime, false otherwise.
+     */
+    static bool isPrime(const Int& n)
+    {
+        if (n <= Int((unsigned long) LONG_MAX))
+        {
+            return GFSieve::millerRabin((long) GFWideTraits<Int>::low64(n));
+        }
+        for (const unsigned long& base : WIDE_MILLER_RABIN_BASES)
+        {
+            if (n % Int(base) == Int(0))
+            {
+                return false;
+            }
+        }
+        Int d = n - Int(1);
+        int s = 0;
+        while ((d & Int(1)) == Int(0))
+        {
+            d >>= 1;
+            s++;
+        }
+        GFMontgomery<Int> mont(n);
+        Int minusOne = mont.subtract(Int(0), mont.one());
+        for (const unsigned long& base : WIDE_MILLER_RABIN_BASES)
+        {
+            Int x = mont.power(mont.toMontgomery(Int(base)), d);
+            if (x == mont.one() || x == minusOne)
+            {
+                continue;
+            }
+            bool composite = true;
+            for (int i = 1; composite && i < s; i++)
+            {
+                x = mont.multiply(x, x);
+                composite = x != minusOne;
+            }
+            if (composite)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @param other Reference to another GFWideField object.
+     * @return true if the chars and the degrees are equal, false otherwise.
+     */
+    bool operator==(const GFWideField& other) const
+    {
+        return _char == other._char && _deg == other._deg;
+    }
+
+    /**
+     * @param other Reference to another GFWideField object.
+     * @return true if the chars or the degrees are different, false otherwise.
+     */
+    bool operator!=(const GFWideField& other) const
+    {
+        return !(*this == other);
+    }
+
+    /**
+     * Prints the object to the given stream.
+     * @param s Out stream to print to.
+     * @param obj Object to print.
+     * @return The given out stream.
+     */
+    friend std::ostream& operator<<(std::ostream& s, const GFWideField& obj)
+    {
+        s << "GF(" << gfToString(obj._char) << "**" << obj._deg << ")";
+        return s;
+    }
+};
+
+#endif //EX1_GFWIDEFIELD_H
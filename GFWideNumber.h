@@ -0,0 +1,341 @@
+#ifndef EX1_GFWIDENUMBER_H
+#define EX1_GFWIDENUMBER_H
+
+#include <algorithm>
+#include <vector>
+#include "GFWideField.h"
+
+/**
+ * Defines the largest prime that the wide factorization divides out before Pollard Rho.
+ */
+const unsigned long WIDE_TRIAL_LIMIT = 1000;
+
+/**
+ * Defines the amount of steps whose differences are multiplied together before one gcd, in
+ * Brent's variant of Pollard Rho.
+ */
+const int WIDE_RHO_BATCH = 128;
+
+/**
+ * Defines the longest cycle that Brent's variant of Pollard Rho looks for before it tries another
+ * polynomial.
+ */
+const long WIDE_RHO_MAX_CYCLE = 1L << 24;
+
+/**
+ * Defines the amount of polynomials Brent's variant of Pollard Rho tries before it gives up.
+ */
+const int WIDE_RHO_ATTEMPTS = 8;
+
+/**
+ * GFWideNumber class, a GFNumber whose number is kept in a wider backing integer - Int, which is
+ * unsigned long, unsigned __int128 or GFUInt (256 or 512 bits), with a GFWideField of the same
+ * width. The arithmetic is modulo the order of the field, and the factorization uses Brent's
+ * variant of Pollard Rho in Montgomery form.
+ */
+template <typename Int>
+class GFWideNumber
+{
+private:
+    GFWideField<Int> _f;
+    Int _n;
+
+    /**
+     * Finds a factor of the given odd composite number by Brent's variant of Pollard Rho - the
+     * differences of many steps of x**2 + c are multiplied together in Montgomery form, and one
+     * gcd checks them all.
+     * @param n The odd composite number.
+     * @return A factor of n bigger than 1 and smaller than n, or n if none was found.
+     */
+    static Int _pollardBrent(const Int& n)
+    {
+        GFMontgomery<Int> mont(n);
+        for (int attempt = 1; attempt <= WIDE_RHO_ATTEMPTS; attempt++)
+        {
+            Int c = mont.toMontgomery(Int((unsigned long) attempt));
+            Int y = mont.toMontgomery(Int(2)), x = y, ys = y, q = mont.one(), g = Int(1);
+            auto step = [&mont, &c](const Int& v)
+            {
+                return mont.add(mont.multiply(v, v), c);
+            };
+            for (long r = 1; g == Int(1) && r <= WIDE_RHO_MAX_CYCLE; r *= 2)
+            {
+                x = y;
+                for (long i = 0; i < r; i++)
+                {
+                    y = step(y);
+                }
+                for (long k = 0; k < r && g == Int(1); k += WIDE_RHO_BATCH)
+                {
+                    ys = y;
+                    for (long i = 0; i < std::min((long) WIDE_RHO_BATCH, r - k); i++)
+                    {
+                        y = step(y);
+                        q = mont.multiply(q, (x > y) ? x - y : y - x);
+                    }
+                    g = gfGcd(q, n);
+                }
+            }
+            if (g == n)
+            {
+                do
+                {
+                    ys = step(ys);
+                    g = gfGcd((x > ys) ? x - ys : ys - x, n);
+                } while (g == Int(1));
+            }
+            if (g != n && g != Int(1))
+            {
+                return g;
+            }
+        }
+        return n;
+    }
+
+    /**
+     * Adds the prime factors of the given number to the given vector - by trial division of the
+     * small primes, and then by splitting the rest with Pollard Rho recursively.
+     * @param n The number to factor, bigger than 1.
+     * @param res The vector to add the factors to.
+     */
+    static void _factor(Int n, std::vector<Int>& res)
+    {
+        for (unsigned long p = 2; p < WIDE_TRIAL_LIMIT && Int(p) * Int(p) <= n; p++)
+        {
+            while (n % Int(p) == Int(0))
+            {
+                res.push_back(Int(p));
+                n /= Int(p);
+            }
+        }
+        std::vector<Int> stack;
+        if (n != Int(1))
+        {
+            stack.push_back(n);
+        }
+        while (!stack.empty())
+        {
+            Int cur = stack.back();
+            stack.pop_back();
+            if (GFWideField<Int>::isPrime(cur))
+            {
+                res.push_back(cur);
+                continue;
+            }
+            Int d = _pollardBrent(cur);
+            if (d == cur)
+            {
+                res.push_back(cur);
+                continue;
+            }
+            stack.push_back(d);
+            stack.push_back(cur / d);
+        }
+        std::sort(res.begin(), res.end());
+    }
+
+public:
+    /**
+     * Two arguments constructor.
+     * @param n The number, modulo the order of the field.
+     * @param f The GFWideField of this number.
+     */
+    GFWideNumber(const Int& n, const GFWideField<Int>& f) : _f(f), _n(n % f.getOrder())
+    {}
+
+    /**
+     * Constructor that gets only the n, and create a default GFWideField (2, 1).
+     * @param n The number.
+     */
+    GFWideNumber(const Int& n) : GFWideNumber(n, GFWideField<Int>())
+    {}
+
+    /**
+     * Default constructor - create a default n (0) and a default field (2, 1).
+     */
+    GFWideNumber() : GFWideNumber(Int(0))
+    {}
+
+    /**
+     * @return The n of this number.
+     */
+    const Int& getNumber() const
+    {
+        return _n;
+    }
+
+    /**
+     * @return The GFWideField of this number.
+     */
+    const GFWideField<Int>& getField() const
+    {
+        return _f;
+    }
+
+    /**
+     * Check if n is prime.
+     * @return true if n is prime, false otherwise.
+     */
+    bool getIsPrime() const
+    {
+        return GFWideField<Int>::isPrime(_n);
+    }
+
+    /**
+     * Finds all the prime factors of this number and save them in a dynamic allocated array, in
+     * increasing order, it will save the factors amount in the given arrLength pointer. A factor
+     * that Pollard Rho couldn't split is saved whole.
+     * @param arrLength The array length pointer.
+     * @return The array of the prime factors, if n is prime (or 0 or 1) - the array will be empty.
+     */
+    GFWideNumber *getPrimeFactors(int *arrLength) const
+    {
+        std::vector<Int> factors;
+        if (_n > Int(1) && !getIsPrime())
+        {
+            _factor(_n, factors);
+        }
+        *arrLength = (int) factors.size();
+        GFWideNumber *res = new GFWideNumber[factors.size()];
+        for (size_t i = 0; i < factors.size(); i++)
+        {
+            res[i] = GFWideNumber(factors[i], _f);
+        }
+        return res;
+    }
+
+    /**
+     * Print all the prime factors of this number, in the format of GFNumber::printFactors.
+     */
+    void printFactors() const
+    {
+        int arrLength = 0;
+        GFWideNumber *primeFactors = getPrimeFactors(&arrLength);
+        std::cout << gfToString(_n) << "=";
+        if (arrLength == 0)
+        {
+            std::cout << gfToString(_n) << "*1" << std::endl;
+        }
+        for (int i = 0; i < arrLength; i++)
+        {
+            std::cout << gfToString(primeFactors[i]._n) << ((i + 1 < arrLength) ? "*" : "\n");
+        }
+        delete[] primeFactors;
+    }
+
+    /**
+     * @param other The number to add to this one.
+     * @return The sum modulo the order.
+     */
+    GFWideNumber operator+(const GFWideNumber& other) const
+    {
+        assert(_f == other._f);
+        return GFWideNumber(_f.add(_n, other._n), _f);
+    }
+
+    /**
+     * @param other The number to subtract from this one.
+     * @return The difference modulo the order.
+     */
+    GFWideNumber operator-(const GFWideNumber& other) const
+    {
+        assert(_f == other._f);
+        return GFWideNumber(_f.subtract(_n, other._n), _f);
+    }
+
+    /**
+     * @param other The number to multiply this one by.
+     * @return The product modulo the order.
+     */
+    GFWideNumber operator*(const GFWideNumber& other) const
+    {
+        assert(_f == other._f);
+        return GFWideNumber(_f.multiply(_n, other._n), _f);
+    }
+
+    /**
+     * @param other The non zero number to modulo this one by.
+     * @return The remainder of n divided by the other's n.
+     */
+    GFWideNumber operator%(const GFWideNumber& other) const
+    {
+        assert(_f == other._f);
+        assert(other._n != Int(0));
+        return GFWideNumber(_n % other._n, _f);
+    }
+
+    /**
+     * @param other Reference to another GFWideNumber object.
+     * @return true if the n's are equal and the fields are equal, false otherwise.
+     */
+    bool operator==(const GFWideNumber& other) const
+    {
+        return _f == other._f && _n == other._n;
+    }
+
+    /**
+     * @param other Reference to another GFWideNumber object.
+     * @return true if the n's are different or the fields are different, false otherwise.
+     */
+    bool operator!=(const GFWideNumber& other) const
+    {
+        return !(*this == other);
+    }
+
+    /**
+     * @param other Reference to another GFWideNumber object.
+     * @return true if this n is smaller than other's n, false otherwise.
+     */
+    bool operator<(const GFWideNumber& other) const
+    {
+        assert(_f == other._f);
+        return _n < other._n;
+    }
+
+    /**
+     * Prints the object to the given stream.
+     * @param s Out stream to print to.
+     * @param obj Object to print.
+     * @return The given out stream.
+     */
+    friend std::ostream& operator<<(std::ostream& s, const GFWideNumber& obj)
+    {
+        s << gfToString(obj._n) << " " << obj._f;
+        return s;
+    }
+
+    /**
+     * Get a number, a char and a degree as an input and put them into the given obj.
+     * @param s In stream to read the input from.
+     * @param obj GFWideNumber object to put the input object in.
+     * @return The given in stream.
+     */
+    friend std::istream& operator>>(std::istream& s, GFWideNumber& obj)
+    {
+        std::string n, p;
+        long l = 0;
+        Int num, prime;
+        if (!(s >> n >> p >> l) || !gfParse(n, num) || !gfParse(p, prime) || l <= 0 ||
+            !GFWideField<Int>::isPrime(prime))
+        {
+            s.setstate(std::ios::failbit);
+            return s;
+        }
+        obj = GFWideNumber(num, GFWideField<Int>(prime, l));
+        return s;
+    }
+};
+
+/**
+ * The numbers and fields of every backing width.
+ */
+typedef GFWideField<unsigned long> GField64;
+typedef GFWideField<unsigned __int128> GField128;
+typedef GFWideField<GFUInt<4>> GField256;
+typedef GFWideField<GFUInt<8>> GField512;
+typedef GFWideNumber<unsigned long> GFNumber64;
+typedef GFWideNumber<unsigned __int128> GFNumber128;
+typedef GFWideNumber<GFUInt<4>> GFNumber256;
+typedef GFWideNumber<GFUInt<8>> GFNumber512;
+
+#endif //EX1_GFWIDENUMBER_H
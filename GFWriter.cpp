@@ -0,0 +1,211 @@
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <sys/uio.h>
+#include <unistd.h>
+#include "GFWriter.h"
+
+/**
+ * Defines the size of the output buffer.
+ */
+const size_t WRITER_BUFFER_SIZE = 1 << 16;
+
+/**
+ * Defines the maximal length of a formatted long.
+ */
+const size_t MAX_LONG_LENGTH = 20;
+
+/**
+ * Constructor that writes to the given file descriptor.
+ * @param fd The file descriptor to write to.
+ */
+GFWriter::GFWriter(const int& fd) : _fd(fd), _buffer(new char[WRITER_BUFFER_SIZE]), _size(0),
+                                    _fail(false) {}
+
+/**
+ * Default constructor - writes to the standard output.
+ */
+GFWriter::GFWriter() : GFWriter(STDOUT_FILENO) {}
+
+/**
+ * Destructor for the GFWriter object, flushes the buffer.
+ */
+GFWriter::~GFWriter()
+{
+    flush();
+    delete[] _buffer;
+}
+
+/**
+ * @return The standard output writer of the calling thread.
+ */
+GFWriter& GFWriter::local()
+{
+    thread_local GFWriter writer;
+    return writer;
+}
+
+/**
+ * Writes all the given bytes to the file descriptor, and remembers if it failed.
+ * @param data The bytes to write.
+ * @param len The amount of bytes to write.
+ */
+void GFWriter::_writeAll(const char *data, size_t len)
+{
+    while (len > 0)
+    {
+        ssize_t done = ::write(_fd, data, len);
+        if (done < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (done <= 0)
+        {
+            _fail = true;
+            return;
+        }
+        data += done;
+        len -= done;
+    }
+}
+
+/**
+ * Makes sure there are at least the given amount of free bytes in the buffer.
+ * @param len The amount of bytes that are about to be added.
+ */
+void GFWriter::_reserve(const size_t& len)
+{
+    if (_size + len > WRITER_BUFFER_SIZE)
+    {
+        flush();
+    }
+}
+
+/**
+ * Writes the buffer to the file descriptor.
+ */
+void GFWriter::flush()
+{
+    _writeAll(_buffer, _size);
+    _size = 0;
+}
+
+/**
+ * @return true if a write to the file descriptor failed, false otherwise.
+ */
+bool GFWriter::fail() const
+{
+    return _fail;
+}
+
+/**
+ * Adds the given bytes to the output.
+ * Bytes that don't fit in the buffer are written together with it in a single writev call.
+ * @param data The bytes to add.
+ * @param len The amount of bytes to add.
+ * @return This writer.
+ */
+GFWriter& GFWriter::write(const char *data, const size_t& len)
+{
+    if (_size + len <= WRITER_BUFFER_SIZE)
+    {
+        std::memcpy(_buffer + _size, data, len);
+        _size += len;
+        return *this;
+    }
+    struct iovec parts[2] = {{_buffer, _size}, {const_cast<char *>(data), len}};
+    ssize_t done = writev(_fd, parts, 2);
+    while (done < 0 && errno == EINTR)
+    {
+        done = writev(_fd, parts, 2);
+    }
+    size_t written = (done < 0) ? 0 : done;
+    if (written < _size)
+    {
+        _writeAll(_buffer + written, _size - written);
+        written = _size;
+    }
+    _writeAll(data + (written - _size), len - (written - _size));
+    _size = 0;
+    return *this;
+}
+
+/**
+ * Adds the factorization of the given number in the format "n=p1*p2*...*pk" and a new line.
+ * @param num The number to factorize.
+ * @return This writer.
+ */
+GFWriter& GFWriter::writeFactors(const GFNumber& num)
+{
+    int arrLength = 0;
+    GFArena& arena = GFArena::local();
+    GFArena::Mark mark = arena.getMark();
+    GFNumber *primeFactors = num.getPrimeFactors(&arrLength, arena);
+    *this << num.getNumber() << '=';
+    if (arrLength == 0)
+    {
+        *this << num.getNumber() << "*1";
+    }
+    else
+    {
+        for (int i = 0; i < arrLength - 1; i++)
+        {
+            *this << primeFactors[i].getNumber() << '*';
+        }
+        *this << primeFactors[arrLength - 1].getNumber();
+    }
+    *this << '\n';
+    arena.rewind(mark);
+    return *this;
+}
+
+/**
+ * @param i The long to add.
+ * @return This writer.
+ */
+GFWriter& GFWriter::operator<<(const long& i)
+{
+    _reserve(MAX_LONG_LENGTH);
+    _size = std::to_chars(_buffer + _size, _buffer + WRITER_BUFFER_SIZE, i).ptr - _buffer;
+    return *this;
+}
+
+/**
+ * @param c The char to add.
+ * @return This writer.
+ */
+GFWriter& GFWriter::operator<<(const char& c)
+{
+    _reserve(1);
+    _buffer[_size++] = c;
+    return *this;
+}
+
+/**
+ * @param str The null terminated string to add.
+ * @return This writer.
+ */
+GFWriter& GFWriter::operator<<(const char *str)
+{
+    return write(str, std::strlen(str));
+}
+
+/**
+ * Adds the field in the format "GF(p**l)".
+ * @param obj The field to add.
+ * @return This writer.
+ */
+GFWriter& GFWriter::operator<<(const GField& obj)
+{
+    return *this << "GF(" << obj.getChar() << "**" << obj.getDegree() << ')';
+}
+
+/**
+ * Adds the number in the format "n GF(p**l)".
+ * @param obj The number to add.
+ * @return This writer.
+ */
+GFWriter& GFWriter::operator<<(const GFNumber& obj)
+{
+    return *this << obj.getNumber() << ' ' << obj.getField();
+}
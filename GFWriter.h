@@ -0,0 +1,122 @@
+#ifndef EX1_GFWRITER_H
+#define EX1_GFWRITER_H
+
+#include <cstddef>
+#include "GFNumber.h"
+
+/**
+ * GFWriter class, that formats numbers, fields and factorizations into a large buffer and writes
+ * it to a file descriptor in big chunks, with the same text as the stream operators.
+ */
+class GFWriter
+{
+private:
+    int _fd;
+    char *_buffer;
+    size_t _size;
+    bool _fail;
+
+    /**
+     * Makes sure there are at least the given amount of free bytes in the buffer.
+     * @param len The amount of bytes that are about to be added.
+     */
+    void _reserve(const size_t& len);
+
+    /**
+     * Writes all the given bytes to the file descriptor.
+     * @param data The bytes to write.
+     * @param len The amount of bytes to write.
+     */
+    void _writeAll(const char *data, size_t len);
+
+public:
+    /**
+     * Constructor that writes to the given file descriptor.
+     * @param fd The file descriptor to write to.
+     */
+    GFWriter(const int& fd);
+
+    /**
+     * Default constructor - writes to the standard output.
+     */
+    GFWriter();
+
+    /**
+     * The writer owns its buffer, so it can't be copied.
+     */
+    GFWriter(const GFWriter& other) = delete;
+
+    /**
+     * Destructor for the GFWriter object, flushes the buffer.
+     */
+    ~GFWriter();
+
+    /**
+     * The writer owns its buffer, so it can't be assigned.
+     */
+    GFWriter& operator=(const GFWriter& other) = delete;
+
+    /**
+     * @return The standard output writer of the calling thread.
+     */
+    static GFWriter& local();
+
+    /**
+     * Adds the given bytes to the output.
+     * @param data The bytes to add.
+     * @param len The amount of bytes to add.
+     * @return This writer.
+     */
+    GFWriter& write(const char *data, const size_t& len);
+
+    /**
+     * Adds the factorization of the given number in the format "n=p1*p2*...*pk" and a new line.
+     * @param num The number to factorize.
+     * @return This writer.
+     */
+    GFWriter& writeFactors(const GFNumber& num);
+
+    /**
+     * Writes the buffer to the file descriptor.
+     */
+    void flush();
+
+    /**
+     * @return true if a write to the file descriptor failed, false otherwise.
+     */
+    bool fail() const;
+
+    /**
+     * @param i The long to add.
+     * @return This writer.
+     */
+    GFWriter& operator<<(const long& i);
+
+    /**
+     * @param c The char to add.
+     * @return This writer.
+     */
+    GFWriter& operator<<(const char& c);
+
+    /**
+     * @param str The null terminated string to add.
+     * @return This writer.
+     */
+    GFWriter& operator<<(const char *str);
+
+    /**
+     * Adds the field in the format "GF(p**l)".
+     * @param obj The field to add.
+     * @return This writer.
+     */
+    GFWriter& operator<<(const GField& obj);
+
+    /**
+     * Adds the number in the format "n GF(p**l)".
+     * @param obj The number to add.
+     * @return This writer.
+     */
+    GFWriter& operator<<(const GFNumber& obj);
+};
+
+#endif //EX1_GFWRITER_H
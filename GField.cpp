@@ -2,6 +2,10 @@
 #include <cassert>
 #include "GField.h"
 #include "GFNumber.h"
+#include "GFieldContext.h"
+#include "GFSieve.h"
+#include "GFSmooth.h"
+#include "GFStats.h"
 
 /**
  * Defines the default char.
@@ -13,11 +17,6 @@ const long DEFAULT_CHAR = 2;
  */
 const long DEFAULT_DEG = 1;
 
-/**
- * Defines the smallest prime number.
- */
-const int SMALLEST_PRIME = 2;
-
 /**
  * Constructor that gets two arguments.
  * @param p The char argument.
@@ -29,6 +28,7 @@ GField::GField(const long& p, const long& l)
     assert(isPrime(p));
     _char = std::abs(p);
     _deg = l;
+    _ctx = GFieldContext::get(_char, _deg);
 }
 
 /**
@@ -45,9 +45,10 @@ GField::GField() : GField(DEFAULT_CHAR, DEFAULT_DEG) {}
 
 /**
  * Copy constructor.
+ * The copied object was already validated, so the char is not checked for primality again.
  * @param obj The object to copy from.
  */
-GField::GField(const GField& obj) : GField(obj._char, obj._deg) {}
+GField::GField(const GField& obj) : _char(obj._char), _deg(obj._deg), _ctx(obj._ctx) {}
 
 /**
  * @return The char of the object.
@@ -66,12 +67,13 @@ const long& GField::getDegree() const
 }
 
 /**
- * The order of the object - a power of the char with the degree.
+ * The order of the object - a power of the char with the degree, found once by exact integer
+ * multiplication in the field's context.
  * @return
  */
 long GField::getOrder() const
 {
-    return std::pow(_char, _deg);
+    return _ctx->getOrder();
 }
 
 /**
@@ -81,14 +83,27 @@ long GField::getOrder() const
  */
 bool GField::isPrime(long p)
 {
-    p = std::abs(p);
-    if (p < SMALLEST_PRIME)
+    GF_STATS_COUNT(PRIMALITY_TESTS, 1);
+    return GFSieve::millerRabin(std::abs(p));
+}
+
+/**
+ * Checks if the given char and degree make a valid field - a prime char, a positive degree,
+ * and an order p**l that fits in a long.
+ * @param p The char to check.
+ * @param l The degree to check.
+ * @return true if GF(p**l) is valid, false otherwise.
+ */
+bool GField::isValid(const long& p, const long& l)
+{
+    if (l <= 0 || !isPrime(p))
     {
         return false;
     }
-    for (int i = SMALLEST_PRIME; i <= std::sqrt(p); i++)
+    long order = 1;
+    for (long i = 0; i < l; i++)
     {
-        if (p % i == 0)
+        if (__builtin_mul_overflow(order, std::abs(p), &order))
         {
             return false;
         }
@@ -97,7 +112,24 @@ bool GField::isPrime(long p)
 }
 
 /**
- * Finds the greatest common divisor of the two given GFNumbers.
+ * Checks if many longs are prime numbers at once, several of them in SIMD lanes.
+ * @param nums The longs to check.
+ * @param len The amount of longs.
+ * @param res The array to put in whether every long is prime.
+ */
+void GField::arePrime(const long *nums, const int& len, bool *res)
+{
+    GF_STATS_COUNT(PRIMALITY_TESTS, len);
+    std::vector<long> values(len);
+    for (int i = 0; i < len; i++)
+    {
+        values[i] = std::abs(nums[i]);
+    }
+    GFSieve::millerRabinBatch(values.data(), len, res);
+}
+
+/**
+ * Finds the greatest common divisor of the two given GFNumbers, by the Euclidean algorithm.
  * @param a The first GFNumber.
  * @param b The second GFNumber.
  * @return The greatest common divisor.
@@ -107,6 +139,7 @@ GFNumber GField::gcd(const GFNumber& a, const GFNumber& b) const
     assert(a.getField() == *this);
     assert(b.getField() == *this);
     assert(a.getNumber() != 0 || b.getNumber() != 0);
+    GF_STATS_COUNT(GCD_CALLS, 1);
     if (a.getNumber() == 0)
     {
         return b;
@@ -115,14 +148,295 @@ GFNumber GField::gcd(const GFNumber& a, const GFNumber& b) const
     {
         return a;
     }
-    for (long i = std::min(a.getNumber(), b.getNumber()); i > 1; i--)
+    long x = a.getNumber(), y = b.getNumber();
+    while (y != 0)
+    {
+        long temp = x % y;
+        x = y;
+        y = temp;
+    }
+    return createNumber(x);
+}
+
+/**
+ * @return The coefficients of the irreducible polynomial that defines GF(p**l) as an extension
+ * field, from the free coefficient up to the leading 1.
+ */
+const std::vector<long>& GField::getModulus() const
+{
+    return _ctx->getModulus();
+}
+
+/**
+ * Adds two elements of the extension field, given as residues whose base p digits are the
+ * coefficients of their polynomials.
+ * @param a The first element.
+ * @param b The second element.
+ * @return The sum of the elements.
+ */
+long GField::addElements(const long& a, const long& b) const
+{
+    return _ctx->add(a, b);
+}
+
+/**
+ * Subtracts two elements of the extension field, given as residues.
+ * @param a The first element.
+ * @param b The second element.
+ * @return The difference of the elements.
+ */
+long GField::subtractElements(const long& a, const long& b) const
+{
+    return _ctx->subtract(a, b);
+}
+
+/**
+ * Multiplies two elements of the extension field, given as residues.
+ * @param a The first element.
+ * @param b The second element.
+ * @return The product of the elements modulo the irreducible polynomial.
+ */
+long GField::multiplyElements(const long& a, const long& b) const
+{
+    return _ctx->multiply(a, b);
+}
+
+/**
+ * Finds the inverse of an element of the extension field, given as a residue.
+ * @param a The non zero element.
+ * @return The multiplicative inverse of the element.
+ */
+long GField::inverseElement(const long& a) const
+{
+    return _ctx->inverse(a);
+}
+
+/**
+ * Raises an element of the extension field, given as a residue, to the given power.
+ * @param a The element.
+ * @param e The non negative exponent.
+ * @return a to the power of e.
+ */
+long GField::powerElement(const long& a, const long& e) const
+{
+    return _ctx->power(a, e);
+}
+
+/**
+ * Sets the largest order whose residues get multiplication and inverse tables, shared by all
+ * the GFNumbers of the field - for the fields that are first created after it.
+ * @param order The largest order, clamped to 2**16, 0 for no tables.
+ */
+void GField::setResidueTablesMaxOrder(const long& order)
+{
+    GFieldContext::setResidueTablesMaxOrder(order);
+}
+
+/**
+ * @return The largest order whose residues get multiplication and inverse tables.
+ */
+long GField::getResidueTablesMaxOrder()
+{
+    return GFieldContext::getResidueTablesMaxOrder();
+}
+
+/**
+ * @return true if the residues of this field have a table of products or logarithm tables -
+ * orders up to 2**8, and larger prime orders.
+ */
+bool GField::hasProductTables() const
+{
+    return _ctx->hasProductTables();
+}
+
+/**
+ * @return true if the residues of this field have a table of inverses.
+ */
+bool GField::hasInverseTables() const
+{
+    return _ctx->hasInverseTables();
+}
+
+/**
+ * Multiplies two residues modulo p**l, by the tables when the field has them.
+ * @param a The first residue, in [0, p**l).
+ * @param b The second residue, in [0, p**l).
+ * @return The product of the residues modulo p**l.
+ */
+long GField::multiplyResidues(const long& a, const long& b) const
+{
+    return _ctx->multiplyResidues(a, b);
+}
+
+/**
+ * Finds the inverse of a residue modulo p**l, by the tables when the field has them.
+ * @param a A residue in [0, p**l), not divisible by p.
+ * @return The inverse of the residue modulo p**l.
+ */
+long GField::inverseResidue(const long& a) const
+{
+    return _ctx->inverseResidue(a);
+}
+
+/**
+ * The factorization of the order of the multiplicative group (p**l - 1), found once per field
+ * and shared by all its GField objects.
+ * @return The prime factors and their exponents, sorted by the primes.
+ */
+const std::vector<std::pair<long, int>>& GField::getGroupFactors() const
+{
+    return _ctx->getGroupFactors(*this);
+}
+
+/**
+ * @return The smallest generator of the multiplicative group of the field.
+ */
+GFNumber GField::primitiveRoot() const
+{
+    return createNumber(_ctx->getPrimitiveRoot(*this));
+}
+
+/**
+ * Finds the multiplicative orders of many elements, with the shared factorization of the group
+ * order - the order of a starts as p**l - 1, and is divided by every prime factor q as long as
+ * a to the power of the order over q is still 1.
+ * @param nums Non zero GFNumbers of this field.
+ * @param len The amount of GFNumbers.
+ * @param res The array to put the orders in.
+ */
+void GField::multiplicativeOrders(const GFNumber *nums, const int& len, long *res) const
+{
+    const std::vector<std::pair<long, int>>& factors = getGroupFactors();
+    long groupOrder = getOrder() - 1;
+    for (int i = 0; i < len; i++)
+    {
+        assert(nums[i].getField() == *this);
+        assert(nums[i].getNumber() != 0);
+        long order = groupOrder;
+        for (const std::pair<long, int>& factor : factors)
+        {
+            for (int j = 0; j < factor.second; j++)
+            {
+                if (_ctx->power(nums[i].getNumber(), order / factor.first) != 1)
+                {
+                    break;
+                }
+                order /= factor.first;
+            }
+        }
+        res[i] = order;
+    }
+}
+
+/**
+ * Finds the inverses modulo p**l of many GFNumbers at once - by Montgomery's trick, the prefix
+ * products are inverted once, and every inverse is split from it by two products. A field with
+ * tables looks every inverse up instead.
+ * @param nums GFNumbers of this field, not divisible by p.
+ * @param len The amount of GFNumbers.
+ * @param res The array to put the inverses in.
+ */
+void GField::inverses(const GFNumber *nums, const int& len, GFNumber *res) const
+{
+    if (len <= 0)
     {
-        if (a.getNumber() % i == 0 && b.getNumber() % i == 0)
+        return;
+    }
+    if (hasInverseTables())
+    {
+        for (int i = 0; i < len; i++)
         {
-            return createNumber(i);
+            assert(nums[i].getField() == *this);
+            res[i] = createNumber(_ctx->inverseResidue(nums[i].getNumber()));
         }
+        return;
+    }
+    std::vector<GFNumber> prefix(len);
+    for (int i = 0; i < len; i++)
+    {
+        assert(nums[i].getField() == *this);
+        prefix[i] = (i == 0) ? nums[i] : prefix[i - 1] * nums[i];
+    }
+    GFNumber inverse = prefix[len - 1].inverse();
+    for (int i = len - 1; i > 0; i--)
+    {
+        res[i] = inverse * prefix[i - 1];
+        inverse *= nums[i];
+    }
+    res[0] = inverse;
+}
+
+/**
+ * Finds square roots modulo p**l of many GFNumbers.
+ * @param nums GFNumbers of this field.
+ * @param len The amount of GFNumbers.
+ * @param res The array to put the square roots in.
+ * @param found The array to put in whether every GFNumber is a square.
+ */
+void GField::sqrts(const GFNumber *nums, const int& len, GFNumber *res, bool *found) const
+{
+    for (int i = 0; i < len; i++)
+    {
+        assert(nums[i].getField() == *this);
+        found[i] = nums[i].sqrt(res[i]);
+    }
+}
+
+/**
+ * Finds the B-smooth parts of many GFNumbers at once, by one product tree per group of them.
+ * @param nums GFNumbers of this field.
+ * @param len The amount of GFNumbers.
+ * @param bound The bound B.
+ * @param res The array to put the smooth parts in.
+ */
+void GField::smoothParts(const GFNumber *nums, const int& len, const long& bound,
+                         GFNumber *res) const
+{
+    std::vector<long> numbers(len), parts(len);
+    for (int i = 0; i < len; i++)
+    {
+        assert(nums[i].getField() == *this);
+        numbers[i] = nums[i].getNumber();
+    }
+    GFSmooth::smoothParts(numbers.data(), len, bound, parts.data());
+    for (int i = 0; i < len; i++)
+    {
+        res[i] = createNumber(parts[i]);
     }
-    return createNumber(1);
+}
+
+/**
+ * Checks if many GFNumbers are B-smooth at once, by one product tree per group of them.
+ * @param nums GFNumbers of this field.
+ * @param len The amount of GFNumbers.
+ * @param bound The bound B.
+ * @param res The array to put in whether every GFNumber is positive and B-smooth.
+ */
+void GField::areSmooth(const GFNumber *nums, const int& len, const long& bound, bool *res) const
+{
+    std::vector<GFNumber> parts(len);
+    smoothParts(nums, len, bound, parts.data());
+    for (int i = 0; i < len; i++)
+    {
+        res[i] = nums[i].getNumber() > 0 && parts[i] == nums[i];
+    }
+}
+
+/**
+ * Checks if the residues of many GFNumbers are prime numbers at once.
+ * @param nums GFNumbers of this field.
+ * @param len The amount of GFNumbers.
+ * @param res The array to put in whether every residue is prime.
+ */
+void GField::arePrime(const GFNumber *nums, const int& len, bool *res) const
+{
+    std::vector<long> residues(len);
+    for (int i = 0; i < len; i++)
+    {
+        assert(nums[i].getField() == *this);
+        residues[i] = nums[i].getNumber();
+    }
+    arePrime(residues.data(), len, res);
 }
 
 /**
@@ -178,6 +492,11 @@ std::istream& operator>>(std::istream& s, GField& obj)
     {
         return s;
     }
+    if (!GField::isValid(p, l))
+    {
+        s.setstate(std::ios::failbit);
+        return s;
+    }
     obj = GField(p, l);
     return s;
 }
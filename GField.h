@@ -2,8 +2,11 @@
 #define EX1_GFIELD_H
 
 #include <iostream>
+#include <utility>
+#include <vector>
 
 class GFNumber;
+class GFieldContext;
 
 /**
  * GField class, that has a char - p, and a degree - l.
@@ -12,6 +15,7 @@ class GField
 {
 private:
     long _char, _deg;
+    const GFieldContext *_ctx;
 
 public:
     /**
@@ -35,6 +39,7 @@ public:
 
     /**
      * Copy constructor.
+     * The copied object was already validated, so the char is not checked for primality again.
      * @param obj The object to copy from.
      */
     GField(const GField& obj);
@@ -67,6 +72,23 @@ public:
      */
     static bool isPrime(long p);
 
+    /**
+     * Checks if the given char and degree make a valid field - a prime char, a positive degree,
+     * and an order p**l that fits in a long.
+     * @param p The char to check.
+     * @param l The degree to check.
+     * @return true if GF(p**l) is valid, false otherwise.
+     */
+    static bool isValid(const long& p, const long& l);
+
+    /**
+     * Checks if many longs are prime numbers at once, several of them in SIMD lanes.
+     * @param nums The longs to check.
+     * @param len The amount of longs.
+     * @param res The array to put in whether every long is prime.
+     */
+    static void arePrime(const long *nums, const int& len, bool *res);
+
     /**
      * Finds the greatest common divisor of the two given GFNumbers.
      * @param a The first GFNumber.
@@ -75,6 +97,155 @@ public:
      */
     GFNumber gcd(const GFNumber& a, const GFNumber& b) const;
 
+    /**
+     * @return The coefficients of the irreducible polynomial that defines GF(p**l) as an extension
+     * field, from the free coefficient up to the leading 1.
+     */
+    const std::vector<long>& getModulus() const;
+
+    /**
+     * Adds two elements of the extension field, given as residues whose base p digits are the
+     * coefficients of their polynomials.
+     * @param a The first element.
+     * @param b The second element.
+     * @return The sum of the elements.
+     */
+    long addElements(const long& a, const long& b) const;
+
+    /**
+     * Subtracts two elements of the extension field, given as residues.
+     * @param a The first element.
+     * @param b The second element.
+     * @return The difference of the elements.
+     */
+    long subtractElements(const long& a, const long& b) const;
+
+    /**
+     * Multiplies two elements of the extension field, given as residues.
+     * @param a The first element.
+     * @param b The second element.
+     * @return The product of the elements modulo the irreducible polynomial.
+     */
+    long multiplyElements(const long& a, const long& b) const;
+
+    /**
+     * Finds the inverse of an element of the extension field, given as a residue.
+     * @param a The non zero element.
+     * @return The multiplicative inverse of the element.
+     */
+    long inverseElement(const long& a) const;
+
+    /**
+     * Raises an element of the extension field, given as a residue, to the given power.
+     * @param a The element.
+     * @param e The non negative exponent.
+     * @return a to the power of e.
+     */
+    long powerElement(const long& a, const long& e) const;
+
+    /**
+     * Sets the largest order whose residues get multiplication and inverse tables, shared by all
+     * the GFNumbers of the field - for the fields that are first created after it.
+     * @param order The largest order, clamped to 2**16, 0 for no tables.
+     */
+    static void setResidueTablesMaxOrder(const long& order);
+
+    /**
+     * @return The largest order whose residues get multiplication and inverse tables.
+     */
+    static long getResidueTablesMaxOrder();
+
+    /**
+     * @return true if the residues of this field have a table of products or logarithm tables -
+     * orders up to 2**8, and larger prime orders.
+     */
+    bool hasProductTables() const;
+
+    /**
+     * @return true if the residues of this field have a table of inverses.
+     */
+    bool hasInverseTables() const;
+
+    /**
+     * Multiplies two residues modulo p**l, by the tables when the field has them.
+     * @param a The first residue, in [0, p**l).
+     * @param b The second residue, in [0, p**l).
+     * @return The product of the residues modulo p**l.
+     */
+    long multiplyResidues(const long& a, const long& b) const;
+
+    /**
+     * Finds the inverse of a residue modulo p**l, by the tables when the field has them.
+     * @param a A residue in [0, p**l), not divisible by p.
+     * @return The inverse of the residue modulo p**l.
+     */
+    long inverseResidue(const long& a) const;
+
+    /**
+     * The factorization of the order of the multiplicative group (p**l - 1), found once per field
+     * and shared by all its GField objects.
+     * @return The prime factors and their exponents, sorted by the primes.
+     */
+    const std::vector<std::pair<long, int>>& getGroupFactors() const;
+
+    /**
+     * @return The smallest generator of the multiplicative group of the field.
+     */
+    GFNumber primitiveRoot() const;
+
+    /**
+     * Finds the multiplicative orders of many elements, with the shared factorization of the group
+     * order.
+     * @param nums Non zero GFNumbers of this field.
+     * @param len The amount of GFNumbers.
+     * @param res The array to put the orders in.
+     */
+    void multiplicativeOrders(const GFNumber *nums, const int& len, long *res) const;
+
+    /**
+     * Finds the inverses modulo p**l of many GFNumbers at once, with a single inversion or by the
+     * table of inverses.
+     * @param nums GFNumbers of this field, not divisible by p.
+     * @param len The amount of GFNumbers.
+     * @param res The array to put the inverses in.
+     */
+    void inverses(const GFNumber *nums, const int& len, GFNumber *res) const;
+
+    /**
+     * Finds square roots modulo p**l of many GFNumbers.
+     * @param nums GFNumbers of this field.
+     * @param len The amount of GFNumbers.
+     * @param res The array to put the square roots in.
+     * @param found The array to put in whether every GFNumber is a square.
+     */
+    void sqrts(const GFNumber *nums, const int& len, GFNumber *res, bool *found) const;
+
+    /**
+     * Finds the B-smooth parts of many GFNumbers at once, by one product tree per group of them.
+     * @param nums GFNumbers of this field.
+     * @param len The amount of GFNumbers.
+     * @param bound The bound B.
+     * @param res The array to put the smooth parts in.
+     */
+    void smoothParts(const GFNumber *nums, const int& len, const long& bound, GFNumber *res) const;
+
+    /**
+     * Checks if many GFNumbers are B-smooth at once, by one product tree per group of them.
+     * @param nums GFNumbers of this field.
+     * @param len The amount of GFNumbers.
+     * @param bound The bound B.
+     * @param res The array to put in whether every GFNumber is positive and B-smooth.
+     */
+    void areSmooth(const GFNumber *nums, const int& len, const long& bound, bool *res) const;
+
+    /**
+     * Checks if the residues of many GFNumbers are prime numbers at once.
+     * @param nums GFNumbers of this field.
+     * @param len The amount of GFNumbers.
+     * @param res The array to put in whether every residue is prime.
+     */
+    void arePrime(const GFNumber *nums, const int& len, bool *res) const;
+
     /**
      * Creates a new GFNumber from this GField with the given k.
      * @param k The number to create.
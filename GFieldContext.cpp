@@ -0,0 +1,754 @@
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <map>
+#include <stdexcept>
+#include <utility>
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+#include "GFieldContext.h"
+#include "GFNumber.h"
+
+/**
+ * Calculates the product of two residues modulo m, without overflowing.
+ * @param a The first residue.
+ * @param b The second residue.
+ * @param m The modulo.
+ * @return a * b modulo m.
+ */
+static inline long mulMod(const long& a, const long& b, const long& m)
+{
+    return (long) ((__int128) a * b % m);
+}
+
+/**
+ * Finds the inverse of a residue modulo m by the extended Euclidean algorithm.
+ * @param a The residue, coprime to m.
+ * @param m The modulo.
+ * @return The inverse of a modulo m.
+ */
+static long invMod(const long& a, const long& m)
+{
+    long oldR = a % m, r = m, oldS = 1, s = 0;
+    while (r != 0)
+    {
+        long q = oldR / r;
+        long temp = oldR - q * r;
+        oldR = r;
+        r = temp;
+        temp = oldS - q * s;
+        oldS = s;
+        s = temp;
+    }
+    return (oldS % m + m) % m;
+}
+
+/**
+ * Multiplies two polynomials over GF(2), given as bit masks, without carries - in software.
+ * @param a The first polynomial.
+ * @param b The second polynomial.
+ * @return The product.
+ */
+static unsigned __int128 carrylessMultiplyPortable(const uint64_t& a, uint64_t b)
+{
+    unsigned __int128 res = 0;
+    for (int i = 0; b != 0; i++, b >>= 1)
+    {
+        if (b & 1)
+        {
+            res ^= (unsigned __int128) a << i;
+        }
+    }
+    return res;
+}
+
+#if defined(__x86_64__)
+/**
+ * Multiplies two polynomials over GF(2), given as bit masks, without carries - by PCLMULQDQ.
+ * @param a The first polynomial.
+ * @param b The second polynomial.
+ * @return The product.
+ */
+__attribute__((target("pclmul,sse4.1")))
+static unsigned __int128 carrylessMultiplyHardware(const uint64_t& a, const uint64_t& b)
+{
+    __m128i product = _mm_clmulepi64_si128(_mm_cvtsi64_si128((long long) a),
+                                           _mm_cvtsi64_si128((long long) b), 0);
+    uint64_t low = (uint64_t) _mm_cvtsi128_si64(product);
+    uint64_t high = (uint64_t) _mm_extract_epi64(product, 1);
+    return ((unsigned __int128) high << 64) | low;
+}
+
+/**
+ * @return true if the processor has the carry-less multiplication instruction, false otherwise.
+ */
+static bool detectPclmul()
+{
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("pclmul");
+}
+
+/**
+ * Defines if the processor has the carry-less multiplication instruction.
+ */
+static const bool HAS_PCLMUL = detectPclmul();
+#endif
+
+/**
+ * Multiplies two polynomials over GF(2), given as bit masks, without carries.
+ * @param a The first polynomial.
+ * @param b The second polynomial.
+ * @return The product.
+ */
+static inline unsigned __int128 carrylessMultiply(const uint64_t& a, const uint64_t& b)
+{
+#if defined(__x86_64__)
+    if (HAS_PCLMUL)
+    {
+        return carrylessMultiplyHardware(a, b);
+    }
+#endif
+    return carrylessMultiplyPortable(a, b);
+}
+
+/**
+ * Defines the largest order whose residues get tables, for the contexts that are created from now.
+ */
+static std::atomic<long> residueTablesMaxOrder(RESIDUE_TABLES_MAX_ORDER);
+
+/**
+ * Constructor that gets two arguments, finds the irreducible modulus, and builds the tables of
+ * the residues when the order is small enough. Throws std::overflow_error if p**l doesn't fit in
+ * a long, so GField::isValid should be checked first on untrusted input.
+ * @param p The char of the field.
+ * @param l The degree of the field.
+ */
+GFieldContext::GFieldContext(const long& p, const long& l) : _char(p), _deg(l), _order(1),
+                                                             _binaryModulus(0),
+                                                             _primitiveRoot(1)
+{
+    for (long i = 0; i < l; i++)
+    {
+        if (__builtin_mul_overflow(_order, p, &_order))
+        {
+            throw std::overflow_error("the order of the field doesn't fit in a long");
+        }
+    }
+    _findModulus();
+    if (_char == 2)
+    {
+        for (long i = 0; i <= _deg; i++)
+        {
+            _binaryModulus |= (unsigned long) _modulus[i] << i;
+        }
+    }
+    if (_order <= residueTablesMaxOrder.load())
+    {
+        _buildResidueTables();
+    }
+}
+
+/**
+ * Finds the context of the given field, and creates it if it doesn't exist yet.
+ * @param p The char of the field.
+ * @param l The degree of the field.
+ * @return The context, valid until the program ends.
+ */
+const GFieldContext *GFieldContext::get(const long& p, const long& l)
+{
+    thread_local const GFieldContext *last = nullptr;
+    if (last != nullptr && last->_char == p && last->_deg == l)
+    {
+        return last;
+    }
+    static std::mutex lock;
+    static std::map<std::pair<long, long>, const GFieldContext *> contexts;
+    std::lock_guard<std::mutex> guard(lock);
+    const GFieldContext *& found = contexts[std::make_pair(p, l)];
+    if (found == nullptr)
+    {
+        found = new GFieldContext(p, l);
+    }
+    last = found;
+    return found;
+}
+
+/**
+ * Splits the given residue into its coefficients.
+ * @param a The residue.
+ * @return The l coefficients, from the free one up.
+ */
+std::vector<long> GFieldContext::_unpack(long a) const
+{
+    std::vector<long> coeffs(_deg);
+    for (long i = 0; i < _deg; i++)
+    {
+        coeffs[i] = a % _char;
+        a /= _char;
+    }
+    return coeffs;
+}
+
+/**
+ * Joins the given coefficients into a residue.
+ * @param coeffs The coefficients, from the free one up, at least l of them.
+ * @return The residue.
+ */
+long GFieldContext::_pack(const std::vector<long>& coeffs) const
+{
+    long res = 0;
+    for (long i = _deg - 1; i >= 0; i--)
+    {
+        res = res * _char + coeffs[i];
+    }
+    return res;
+}
+
+/**
+ * Multiplies two polynomials and reduces the product modulo the given monic polynomial.
+ * @param a The first polynomial.
+ * @param b The second polynomial.
+ * @param f The monic modulus.
+ * @return The reduced product, with deg(f) coefficients.
+ */
+std::vector<long> GFieldContext::_polyMulMod(const std::vector<long>& a,
+                                             const std::vector<long>& b,
+                                             const std::vector<long>& f) const
+{
+    size_t deg = f.size() - 1;
+    std::vector<long> product(std::max(a.size() + b.size(), deg + 1), 0);
+    for (size_t i = 0; i < a.size(); i++)
+    {
+        for (size_t j = 0; a[i] != 0 && j < b.size(); j++)
+        {
+            product[i + j] = (product[i + j] + mulMod(a[i], b[j], _char)) % _char;
+        }
+    }
+    for (size_t i = product.size() - 1; i >= deg; i--)
+    {
+        long c = product[i];
+        for (size_t j = 0; c != 0 && j <= deg; j++)
+        {
+            product[i - deg + j] = (product[i - deg + j] + _char - mulMod(c, f[j], _char)) % _char;
+        }
+    }
+    product.resize(deg);
+    return product;
+}
+
+/**
+ * Finds the greatest common divisor of two polynomials.
+ * @param a The first polynomial.
+ * @param b The second polynomial.
+ * @return The degree of the greatest common divisor.
+ */
+long GFieldContext::_polyGcdDegree(std::vector<long> a, std::vector<long> b) const
+{
+    while (!a.empty() && a.back() == 0)
+    {
+        a.pop_back();
+    }
+    while (true)
+    {
+        while (!b.empty() && b.back() == 0)
+        {
+            b.pop_back();
+        }
+        if (b.empty())
+        {
+            return (long) a.size() - 1;
+        }
+        long leadInverse = invMod(b.back(), _char);
+        while (a.size() >= b.size())
+        {
+            long c = mulMod(a.back(), leadInverse, _char);
+            size_t shift = a.size() - b.size();
+            for (size_t j = 0; j < b.size(); j++)
+            {
+                a[shift + j] = (a[shift + j] + _char - mulMod(c, b[j], _char)) % _char;
+            }
+            while (!a.empty() && a.back() == 0)
+            {
+                a.pop_back();
+            }
+        }
+        std::swap(a, b);
+    }
+}
+
+/**
+ * Finds the first monic irreducible polynomial of degree l, by Ben-Or's test - f is irreducible
+ * if gcd(f, x**(p**i) - x) = 1 for every i <= l / 2.
+ */
+void GFieldContext::_findModulus()
+{
+    _modulus.assign(_deg + 1, 0);
+    _modulus[_deg] = 1;
+    if (_deg == 1)
+    {
+        return;
+    }
+    std::vector<long> x(_deg, 0);
+    x[1] = 1;
+    for (long candidate = 1; candidate < _order; candidate++)
+    {
+        if (candidate % _char == 0)
+        {
+            continue;
+        }
+        std::vector<long> f = _unpack(candidate);
+        f.push_back(1);
+        bool irreducible = true;
+        std::vector<long> h = x;
+        for (long i = 1; irreducible && i <= _deg / 2; i++)
+        {
+            std::vector<long> power(_deg, 0);
+            power[0] = 1;
+            for (long e = _char; e > 0; e >>= 1)
+            {
+                if (e & 1)
+                {
+                    power = _polyMulMod(power, h, f);
+                }
+                h = _polyMulMod(h, h, f);
+            }
+            h = power;
+            std::vector<long> diff = h;
+            diff[1] = (diff[1] + _char - 1) % _char;
+            irreducible = _polyGcdDegree(f, diff) == 0;
+        }
+        if (irreducible)
+        {
+            _modulus = f;
+            return;
+        }
+    }
+}
+
+/**
+ * @return true if the field is small enough to have Zech logarithm tables, false otherwise.
+ */
+bool GFieldContext::_useTables() const
+{
+    return _deg > 1 && _order <= EXT_TABLES_MAX_ORDER;
+}
+
+/**
+ * Builds the exponent and logarithm tables of a primitive element - an element whose powers are
+ * all the non zero elements. The exponent table is doubled so a sum of two logarithms needs no
+ * reduction.
+ */
+void GFieldContext::_buildTables() const
+{
+    long groupOrder = _order - 1;
+    std::vector<long> primes;
+    long rest = groupOrder;
+    for (long i = 2; i * i <= rest; i++)
+    {
+        if (rest % i == 0)
+        {
+            primes.push_back(i);
+        }
+        while (rest % i == 0)
+        {
+            rest /= i;
+        }
+    }
+    if (rest > 1)
+    {
+        primes.push_back(rest);
+    }
+    long generator = 2;
+    for (; generator < _order; generator++)
+    {
+        bool primitive = true;
+        for (size_t i = 0; primitive && i < primes.size(); i++)
+        {
+            primitive = _powerDirect(generator, groupOrder / primes[i]) != 1;
+        }
+        if (primitive)
+        {
+            break;
+        }
+    }
+    _exp.resize(2 * groupOrder);
+    _log.assign(_order, 0);
+    _exp[0] = 1;
+    for (long i = 1; i < 2 * groupOrder; i++)
+    {
+        _exp[i] = _multiplyDirect(_exp[i - 1], generator);
+    }
+    for (long i = 0; i < groupOrder; i++)
+    {
+        _log[_exp[i]] = i;
+    }
+}
+
+/**
+ * Builds the tables of the residues modulo p**l. Every residue that isn't divisible by p gets its
+ * inverse. An order up to RESIDUE_PRODUCTS_MAX_ORDER gets the full table of products, and a prime
+ * order above it gets the exponents and logarithms of its first generator - the exponent table is
+ * doubled so a sum of two logarithms needs no reduction. Other orders keep multiplying by %.
+ */
+void GFieldContext::_buildResidueTables()
+{
+    _residueInverses.assign(_order, 0);
+    for (long a = 1; a < _order; a++)
+    {
+        if (a % _char != 0)
+        {
+            _residueInverses[a] = (uint16_t) invMod(a, _order);
+        }
+    }
+    if (_order <= RESIDUE_PRODUCTS_MAX_ORDER)
+    {
+        _residueProducts.resize(_order * _order);
+        for (long a = 0; a < _order; a++)
+        {
+            for (long b = 0; b < _order; b++)
+            {
+                _residueProducts[a * _order + b] = (uint16_t) (a * b % _order);
+            }
+        }
+        return;
+    }
+    if (_deg > 1)
+    {
+        return;
+    }
+    long groupOrder = _order - 1;
+    _residueExp.resize(2 * groupOrder);
+    for (long generator = 2;; generator++)
+    {
+        long x = 1, i = 0;
+        do
+        {
+            _residueExp[i++] = (uint16_t) x;
+            x = x * generator % _order;
+        }
+        while (x != 1);
+        if (i == groupOrder)
+        {
+            break;
+        }
+    }
+    _residueLog.assign(_order, 0);
+    for (long i = 0; i < groupOrder; i++)
+    {
+        _residueExp[groupOrder + i] = _residueExp[i];
+        _residueLog[_residueExp[i]] = (uint16_t) i;
+    }
+}
+
+/**
+ * Multiplies two elements of a binary field, by carry-less multiplication and reduction.
+ * @param a The first element.
+ * @param b The second element.
+ * @return The product.
+ */
+long GFieldContext::_binaryMultiply(const long& a, const long& b) const
+{
+    unsigned __int128 product = carrylessMultiply(a, b);
+    for (long i = 2 * _deg - 2; i >= _deg; i--)
+    {
+        if ((product >> i) & 1)
+        {
+            product ^= (unsigned __int128) _binaryModulus << (i - _deg);
+        }
+    }
+    return (long) product;
+}
+
+/**
+ * Multiplies two elements without the tables.
+ * @param a The first element.
+ * @param b The second element.
+ * @return The product.
+ */
+long GFieldContext::_multiplyDirect(const long& a, const long& b) const
+{
+    if (_char == 2)
+    {
+        return _binaryMultiply(a, b);
+    }
+    if (_deg == 1)
+    {
+        return mulMod(a, b, _char);
+    }
+    return _pack(_polyMulMod(_unpack(a), _unpack(b), _modulus));
+}
+
+/**
+ * Raises an element to the given power without the tables.
+ * @param a The element.
+ * @param e The non negative exponent.
+ * @return a to the power of e.
+ */
+long GFieldContext::_powerDirect(long a, long e) const
+{
+    long res = 1;
+    for (; e > 0; e >>= 1)
+    {
+        if (e & 1)
+        {
+            res = _multiplyDirect(res, a);
+        }
+        a = _multiplyDirect(a, a);
+    }
+    return res;
+}
+
+/**
+ * @return The order of the field - p**l.
+ */
+const long& GFieldContext::getOrder() const
+{
+    return _order;
+}
+
+/**
+ * @return The coefficients of the irreducible modulus, from the free one up to the leading 1.
+ */
+const std::vector<long>& GFieldContext::getModulus() const
+{
+    return _modulus;
+}
+
+/**
+ * Sets the largest order whose residues get tables, for the contexts that are created after it -
+ * the existing contexts keep their tables, or their lack of them. The tables hold 16 bit residues,
+ * so the order is clamped to 2**16.
+ * @param order The largest order, larger ones are clamped to 2**16.
+ */
+void GFieldContext::setResidueTablesMaxOrder(const long& order)
+{
+    residueTablesMaxOrder.store(std::min(order, RESIDUE_TABLES_LIMIT));
+}
+
+/**
+ * @return The largest order whose residues get tables.
+ */
+long GFieldContext::getResidueTablesMaxOrder()
+{
+    return residueTablesMaxOrder.load();
+}
+
+/**
+ * @return true if the residues of this context have a table of products or logarithm tables,
+ * false otherwise.
+ */
+bool GFieldContext::hasProductTables() const
+{
+    return !_residueProducts.empty() || !_residueLog.empty();
+}
+
+/**
+ * @return true if the residues of this context have a table of inverses, false otherwise.
+ */
+bool GFieldContext::hasInverseTables() const
+{
+    return !_residueInverses.empty();
+}
+
+/**
+ * Multiplies two residues by one lookup in the table of products, by the logarithm tables, or by
+ * % when the order has neither.
+ * @param a The first residue, in [0, p**l).
+ * @param b The second residue, in [0, p**l).
+ * @return The product of the residues modulo p**l.
+ */
+long GFieldContext::multiplyResidues(const long& a, const long& b) const
+{
+    if (!_residueProducts.empty())
+    {
+        return _residueProducts[a * _order + b];
+    }
+    if (!_residueLog.empty())
+    {
+        return (a == 0 || b == 0) ? 0 : _residueExp[_residueLog[a] + _residueLog[b]];
+    }
+    return mulMod(a, b, _order);
+}
+
+/**
+ * @param a A residue in [0, p**l), not divisible by p.
+ * @return The inverse of the residue modulo p**l.
+ */
+long GFieldContext::inverseResidue(const long& a) const
+{
+    assert(a % _char != 0);
+    if (!_residueInverses.empty())
+    {
+        return _residueInverses[a];
+    }
+    return invMod(a, _order);
+}
+
+/**
+ * @param a The first element.
+ * @param b The second element.
+ * @return The sum of the elements.
+ */
+long GFieldContext::add(const long& a, const long& b) const
+{
+    if (_char == 2)
+    {
+        return a ^ b;
+    }
+    long res = 0, scale = 1, x = a, y = b;
+    for (long i = 0; i < _deg; i++)
+    {
+        res += ((x % _char + y % _char) % _char) * scale;
+        x /= _char;
+        y /= _char;
+        scale *= _char;
+    }
+    return res;
+}
+
+/**
+ * @param a The first element.
+ * @param b The second element.
+ * @return The difference of the elements.
+ */
+long GFieldContext::subtract(const long& a, const long& b) const
+{
+    if (_char == 2)
+    {
+        return a ^ b;
+    }
+    long res = 0, scale = 1, x = a, y = b;
+    for (long i = 0; i < _deg; i++)
+    {
+        res += ((x % _char - y % _char + _char) % _char) * scale;
+        x /= _char;
+        y /= _char;
+        scale *= _char;
+    }
+    return res;
+}
+
+/**
+ * @param a The first element.
+ * @param b The second element.
+ * @return The product of the elements.
+ */
+long GFieldContext::multiply(const long& a, const long& b) const
+{
+    if (!_useTables())
+    {
+        return _multiplyDirect(a, b);
+    }
+    std::call_once(_tablesOnce, &GFieldContext::_buildTables, this);
+    if (a == 0 || b == 0)
+    {
+        return 0;
+    }
+    return _exp[_log[a] + _log[b]];
+}
+
+/**
+ * @param a A non zero element.
+ * @return The multiplicative inverse of the element.
+ */
+long GFieldContext::inverse(const long& a) const
+{
+    assert(a > 0 && a < _order);
+    if (_useTables())
+    {
+        std::call_once(_tablesOnce, &GFieldContext::_buildTables, this);
+        return _exp[_order - 1 - _log[a]];
+    }
+    if (_deg == 1)
+    {
+        return invMod(a, _char);
+    }
+    return _powerDirect(a, _order - 2);
+}
+
+/**
+ * @param a The element.
+ * @param e The non negative exponent.
+ * @return a to the power of e.
+ */
+long GFieldContext::power(const long& a, const long& e) const
+{
+    if (!_useTables() || e == 0)
+    {
+        return _powerDirect(a, e);
+    }
+    std::call_once(_tablesOnce, &GFieldContext::_buildTables, this);
+    if (a == 0)
+    {
+        return 0;
+    }
+    return _exp[(long) ((__int128) _log[a] * e % (_order - 1))];
+}
+
+/**
+ * Factors the order of the multiplicative group by getPrimeFactors, and finds its first
+ * generator - the first residue g with g**((p**l - 1) / q) != 1 for every prime factor q.
+ * @param f A field of this context, to factor the group order in.
+ */
+void GFieldContext::_factorGroup(const GField& f) const
+{
+    long groupOrder = _order - 1;
+    int arrLength = 0;
+    GFNumber *factors = GFNumber(groupOrder, f).getPrimeFactors(&arrLength);
+    std::vector<long> primes;
+    for (int i = 0; i < arrLength; i++)
+    {
+        primes.push_back(factors[i].getNumber());
+    }
+    delete[] factors;
+    if (primes.empty() && groupOrder > 1)
+    {
+        primes.push_back(groupOrder);
+    }
+    std::sort(primes.begin(), primes.end());
+    for (const long& prime : primes)
+    {
+        if (_groupFactors.empty() || _groupFactors.back().first != prime)
+        {
+            _groupFactors.emplace_back(prime, 0);
+        }
+        _groupFactors.back().second++;
+    }
+    for (long g = (groupOrder > 1) ? 2 : 1; g < _order; g++)
+    {
+        bool primitive = true;
+        for (size_t i = 0; primitive && i < _groupFactors.size(); i++)
+        {
+            primitive = power(g, groupOrder / _groupFactors[i].first) != 1;
+        }
+        if (primitive)
+        {
+            _primitiveRoot = g;
+            break;
+        }
+    }
+}
+
+/**
+ * Factors the order of the multiplicative group (p**l - 1) the first time it's needed.
+ * @param f A field of this context, to factor the group order in.
+ * @return The prime factors of the group order and their exponents, sorted by the primes.
+ */
+const std::vector<std::pair<long, int>>& GFieldContext::getGroupFactors(const GField& f) const
+{
+    std::call_once(_groupOnce, &GFieldContext::_factorGroup, this, std::cref(f));
+    return _groupFactors;
+}
+
+/**
+ * Finds the first generator of the multiplicative group the first time it's needed.
+ * @param f A field of this context, to factor the group order in.
+ * @return The smallest residue whose powers are all the non zero elements.
+ */
+long GFieldContext::getPrimitiveRoot(const GField& f) const
+{
+    std::call_once(_groupOnce, &GFieldContext::_factorGroup, this, std::cref(f));
+    return _primitiveRoot;
+}
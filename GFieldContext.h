@@ -0,0 +1,258 @@
+#ifndef EX1_GFIELDCONTEXT_H
+#define EX1_GFIELDCONTEXT_H
+
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+class GField;
+
+/**
+ * Defines the largest extension field order that gets Zech logarithm tables.
+ */
+const long EXT_TABLES_MAX_ORDER = 1 << 16;
+
+/**
+ * Defines the default largest order whose residues get multiplication and inverse tables.
+ */
+const long RESIDUE_TABLES_MAX_ORDER = 1 << 12;
+
+/**
+ * Defines the largest order that may get tables, since the residues are kept in 16 bits.
+ */
+const long RESIDUE_TABLES_LIMIT = 1 << 16;
+
+/**
+ * Defines the largest order that gets a full table of the products of its residues - larger
+ * orders get logarithm tables instead, when they are prime.
+ */
+const long RESIDUE_PRODUCTS_MAX_ORDER = 1 << 8;
+
+/**
+ * GFieldContext class, the state that all the GField objects with the same char and degree share.
+ * It is created once per field, the first time a GField of it is constructed, and lives until the
+ * program ends.
+ * It holds the arithmetic of GF(p**l) as an extension field - an element is a polynomial over GF(p)
+ * of degree smaller than l, stored in a residue n in [0, p**l) whose base p digits are the
+ * coefficients (the lowest digit is the free coefficient), and products are reduced modulo an
+ * irreducible monic polynomial of degree l.
+ */
+class GFieldContext
+{
+private:
+    long _char, _deg, _order;
+    std::vector<long> _modulus;
+    unsigned long _binaryModulus;
+    mutable std::once_flag _tablesOnce;
+    mutable std::vector<long> _exp, _log;
+    mutable std::once_flag _groupOnce;
+    mutable std::vector<std::pair<long, int>> _groupFactors;
+    mutable long _primitiveRoot;
+    std::vector<uint16_t> _residueProducts, _residueExp, _residueLog, _residueInverses;
+
+    /**
+     * Constructor that gets two arguments, and finds the irreducible modulus. Throws
+     * std::overflow_error if p**l doesn't fit in a long.
+     * @param p The char of the field.
+     * @param l The degree of the field.
+     */
+    GFieldContext(const long& p, const long& l);
+
+    /**
+     * Finds the first monic irreducible polynomial of degree l, by Ben-Or's test.
+     */
+    void _findModulus();
+
+    /**
+     * Builds the exponent and logarithm tables of a primitive element.
+     */
+    void _buildTables() const;
+
+    /**
+     * Builds the tables of the residues modulo p**l - the inverses, and the products or the
+     * exponents and logarithms of a generator.
+     */
+    void _buildResidueTables();
+
+    /**
+     * Factors the order of the multiplicative group, and finds its first generator.
+     * @param f A field of this context, to factor the group order in.
+     */
+    void _factorGroup(const GField& f) const;
+
+    /**
+     * @return true if the field is small enough to have Zech logarithm tables, false otherwise.
+     */
+    bool _useTables() const;
+
+    /**
+     * Splits the given residue into its coefficients.
+     * @param a The residue.
+     * @return The l coefficients, from the free one up.
+     */
+    std::vector<long> _unpack(long a) const;
+
+    /**
+     * Joins the given coefficients into a residue.
+     * @param coeffs The coefficients, from the free one up, at least l of them.
+     * @return The residue.
+     */
+    long _pack(const std::vector<long>& coeffs) const;
+
+    /**
+     * Multiplies two polynomials and reduces the product modulo the given monic polynomial.
+     * @param a The first polynomial.
+     * @param b The second polynomial.
+     * @param f The monic modulus.
+     * @return The reduced product, with deg(f) coefficients.
+     */
+    std::vector<long> _polyMulMod(const std::vector<long>& a, const std::vector<long>& b,
+                                  const std::vector<long>& f) const;
+
+    /**
+     * Finds the greatest common divisor of two polynomials.
+     * @param a The first polynomial.
+     * @param b The second polynomial.
+     * @return The degree of the greatest common divisor.
+     */
+    long _polyGcdDegree(std::vector<long> a, std::vector<long> b) const;
+
+    /**
+     * Multiplies two elements of a binary field, by carry-less multiplication and reduction.
+     * @param a The first element.
+     * @param b The second element.
+     * @return The product.
+     */
+    long _binaryMultiply(const long& a, const long& b) const;
+
+    /**
+     * Multiplies two elements without the tables.
+     * @param a The first element.
+     * @param b The second element.
+     * @return The product.
+     */
+    long _multiplyDirect(const long& a, const long& b) const;
+
+    /**
+     * Raises an element to the given power without the tables.
+     * @param a The element.
+     * @param e The non negative exponent.
+     * @return a to the power of e.
+     */
+    long _powerDirect(long a, long e) const;
+
+public:
+    /**
+     * Finds the context of the given field, and creates it if it doesn't exist yet.
+     * @param p The char of the field.
+     * @param l The degree of the field.
+     * @return The context, valid until the program ends.
+     */
+    static const GFieldContext *get(const long& p, const long& l);
+
+    /**
+     * The context is shared by its address, so it can't be copied.
+     */
+    GFieldContext(const GFieldContext& other) = delete;
+
+    /**
+     * The context is shared by its address, so it can't be assigned.
+     */
+    GFieldContext& operator=(const GFieldContext& other) = delete;
+
+    /**
+     * @return The order of the field - p**l.
+     */
+    const long& getOrder() const;
+
+    /**
+     * @return The coefficients of the irreducible modulus, from the free one up to the leading 1.
+     */
+    const std::vector<long>& getModulus() const;
+
+    /**
+     * Sets the largest order whose residues get tables, for the contexts that are created after it.
+     * @param order The largest order, larger ones are clamped to 2**16.
+     */
+    static void setResidueTablesMaxOrder(const long& order);
+
+    /**
+     * @return The largest order whose residues get tables.
+     */
+    static long getResidueTablesMaxOrder();
+
+    /**
+     * @return true if the residues of this context have a table of products or logarithm tables,
+     * false otherwise.
+     */
+    bool hasProductTables() const;
+
+    /**
+     * @return true if the residues of this context have a table of inverses, false otherwise.
+     */
+    bool hasInverseTables() const;
+
+    /**
+     * @param a The first residue, in [0, p**l).
+     * @param b The second residue, in [0, p**l).
+     * @return The product of the residues modulo p**l.
+     */
+    long multiplyResidues(const long& a, const long& b) const;
+
+    /**
+     * @param a A residue in [0, p**l), not divisible by p.
+     * @return The inverse of the residue modulo p**l.
+     */
+    long inverseResidue(const long& a) const;
+
+    /**
+     * @param a The first element.
+     * @param b The second element.
+     * @return The sum of the elements.
+     */
+    long add(const long& a, const long& b) const;
+
+    /**
+     * @param a The first element.
+     * @param b The second element.
+     * @return The difference of the elements.
+     */
+    long subtract(const long& a, const long& b) const;
+
+    /**
+     * @param a The first element.
+     * @param b The second element.
+     * @return The product of the elements.
+     */
+    long multiply(const long& a, const long& b) const;
+
+    /**
+     * @param a A non zero element.
+     * @return The multiplicative inverse of the element.
+     */
+    long inverse(const long& a) const;
+
+    /**
+     * @param a The element.
+     * @param e The non negative exponent.
+     * @return a to the power of e.
+     */
+    long power(const long& a, const long& e) const;
+
+    /**
+     * Factors the order of the multiplicative group (p**l - 1) the first time it's needed.
+     * @param f A field of this context, to factor the group order in.
+     * @return The prime factors of the group order and their exponents, sorted by the primes.
+     */
+    const std::vector<std::pair<long, int>>& getGroupFactors(const GField& f) const;
+
+    /**
+     * Finds the first generator of the multiplicative group the first time it's needed.
+     * @param f A field of this context, to factor the group order in.
+     * @return The smallest residue whose powers are all the non zero elements.
+     */
+    long getPrimitiveRoot(const GField& f) const;
+};
+
+#endif //EX1_GFIELDCONTEXT_H
@@ -1,22 +1,42 @@
 #include "GFNumber.h"
+#include "GFParser.h"
+#include "GFStats.h"
+#include "GFWriter.h"
 #include <cassert>
+#include <cstring>
 
 /**
  * Runs the main program, get two GFNumber as an input from the user, and print few calculations on t
  * hem. it will also print their prime factors.
+ * usage: IntegerFactorization [--stats]
+ * With --stats, the counters and timers of the factorization are printed to the standard error.
  * @return EXIT_FAILURE if the input is invalid, EXIT_SUCCESS if the prigram run successfuly.
  */
-int main()
+int main(int argc, char *argv[])
 {
+    bool printStats = argc > 1 && std::strcmp(argv[1], "--stats") == 0;
     GFNumber first, second;
-    std::cin >> first >> second;
-    assert(!std::cin.fail());
+    GFParser in;
+    if (!in.nextNumber(first) || !in.nextNumber(second))
+    {
+        return EXIT_FAILURE;
+    }
     assert(first.getField() == second.getField());
-    std::cout << first + second << std::endl;
-    std::cout << first - second << std::endl;
-    std::cout << second - first << std::endl;
-    std::cout << first * second << std::endl;
-    first.printFactors();
-    second.printFactors();
+    GFWriter& out = GFWriter::local();
+    out << first + second << '\n';
+    out << first - second << '\n';
+    out << second - first << '\n';
+    out << first * second << '\n';
+    out.writeFactors(first);
+    out.writeFactors(second);
+    out.flush();
+    if (printStats && GFStats::isEnabled())
+    {
+        std::cerr << GFStats::snapshot();
+    }
+    else if (printStats)
+    {
+        std::cerr << "statistics are disabled in this build (GF_ENABLE_STATS)" << std::endl;
+    }
     return EXIT_SUCCESS;
 }
@@ -0,0 +1,148 @@
+#include <cassert>
+#include <map>
+#include "RNSBasis.h"
+
+/**
+ * Calculates the product of two residues modulo m, without overflowing.
+ * @param a The first residue.
+ * @param b The second residue.
+ * @param m The modulo.
+ * @return a * b modulo m.
+ */
+static inline long mulMod(const long& a, const long& b, const long& m)
+{
+    return (long) ((__int128) a * b % m);
+}
+
+/**
+ * Finds the inverse of a residue modulo m by the extended Euclidean algorithm.
+ * @param a The residue, coprime to m.
+ * @param m The modulo.
+ * @return The inverse of a modulo m.
+ */
+static long invMod(const long& a, const long& m)
+{
+    long oldR = a % m, r = m, oldS = 1, s = 0;
+    while (r != 0)
+    {
+        long q = oldR / r;
+        long temp = oldR - q * r;
+        oldR = r;
+        r = temp;
+        temp = oldS - q * s;
+        oldS = s;
+        s = temp;
+    }
+    return (oldS % m + m) % m;
+}
+
+/**
+ * Constructor that gets the fields, and finds the Garner constants - for every channel i, the
+ * products of the moduli before it modulo m[i], and the inverse of the product of all of them.
+ * @param fields The fields of the channels, with different chars.
+ */
+RNSBasis::RNSBasis(const std::vector<GField>& fields) : _fields(fields), _bits(0)
+{
+    assert(!fields.empty());
+    long k = (long) fields.size();
+    for (long i = 0; i < k; i++)
+    {
+        for (long j = 0; j < i; j++)
+        {
+            assert(fields[i].getChar() != fields[j].getChar());
+        }
+        _moduli.push_back(fields[i].getOrder());
+        _bits += 64 - __builtin_clzl((unsigned long) _moduli.back());
+    }
+    _prefix.assign(k * k, 0);
+    _garner.assign(k, 1);
+    for (long i = 0; i < k; i++)
+    {
+        long product = 1 % _moduli[i];
+        for (long j = 0; j < i; j++)
+        {
+            _prefix[i * k + j] = product;
+            product = mulMod(product, _moduli[j] % _moduli[i], _moduli[i]);
+        }
+        _garner[i] = invMod(product, _moduli[i]);
+    }
+}
+
+/**
+ * Finds the basis of the given fields, and creates it if it doesn't exist yet.
+ * @param fields The fields of the channels, with different chars.
+ * @return The basis, valid until the program ends.
+ */
+const RNSBasis *RNSBasis::get(const std::vector<GField>& fields)
+{
+    std::vector<std::pair<long, long>> key;
+    for (const GField& f : fields)
+    {
+        key.emplace_back(f.getChar(), f.getDegree());
+    }
+    static std::mutex lock;
+    static std::map<std::vector<std::pair<long, long>>, const RNSBasis *> bases;
+    std::lock_guard<std::mutex> guard(lock);
+    const RNSBasis *& found = bases[key];
+    if (found == nullptr)
+    {
+        found = new RNSBasis(fields);
+    }
+    return found;
+}
+
+/**
+ * @return The fields of the channels.
+ */
+const std::vector<GField>& RNSBasis::getFields() const
+{
+    return _fields;
+}
+
+/**
+ * @return The moduli of the channels - the orders of the fields.
+ */
+const std::vector<long>& RNSBasis::getModuli() const
+{
+    return _moduli;
+}
+
+/**
+ * @return The amount of channels.
+ */
+long RNSBasis::getChannels() const
+{
+    return (long) _moduli.size();
+}
+
+/**
+ * @return An amount of bits that the product of the moduli fits in.
+ */
+const int& RNSBasis::getBits() const
+{
+    return _bits;
+}
+
+/**
+ * Finds the mixed radix digits of a number by Garner's algorithm - the digits found so far are
+ * summed modulo the next modulo with the precomputed products, and the difference from its
+ * residue is divided by the product of the moduli before it.
+ * @param residues The residues of the number, one per channel.
+ * @param stride The distance between the residues of two channels.
+ * @param digits The array to put the digits in, one per channel.
+ */
+void RNSBasis::mixedRadix(const long *residues, const long& stride, long *digits) const
+{
+    long k = (long) _moduli.size();
+    for (long i = 0; i < k; i++)
+    {
+        const long& m = _moduli[i];
+        long sum = 0;
+        for (long j = 0; j < i; j++)
+        {
+            sum = (long) (((unsigned long) sum + mulMod(digits[j], _prefix[i * k + j], m)) % m);
+        }
+        long diff = residues[i * stride] - sum;
+        digits[i] = mulMod((diff < 0) ? diff + m : diff, _garner[i], m);
+    }
+}
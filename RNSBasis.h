@@ -0,0 +1,101 @@
+#ifndef EX1_RNSBASIS_H
+#define EX1_RNSBASIS_H
+
+#include <cassert>
+#include <mutex>
+#include <vector>
+#include "GField.h"
+#include "GFUInt.h"
+
+/**
+ * RNSBasis class, the moduli of a residue number system - the orders of several GFields with
+ * different chars, so they are pairwise coprime and a number modulo their product is kept as its
+ * residue modulo every one of them (a channel).
+ * It is created once per list of fields and lives until the program ends, and it holds the Garner
+ * constants that rebuild a number from its residues.
+ */
+class RNSBasis
+{
+private:
+    std::vector<GField> _fields;
+    std::vector<long> _moduli;
+    std::vector<long> _garner;
+    std::vector<long> _prefix;
+    int _bits;
+
+    /**
+     * Constructor that gets the fields, and finds the Garner constants.
+     * @param fields The fields of the channels, with different chars.
+     */
+    explicit RNSBasis(const std::vector<GField>& fields);
+
+public:
+    /**
+     * Finds the basis of the given fields, and creates it if it doesn't exist yet.
+     * @param fields The fields of the channels, with different chars.
+     * @return The basis, valid until the program ends.
+     */
+    static const RNSBasis *get(const std::vector<GField>& fields);
+
+    /**
+     * The basis is shared by its address, so it can't be copied.
+     */
+    RNSBasis(const RNSBasis& other) = delete;
+
+    /**
+     * The basis is shared by its address, so it can't be assigned.
+     */
+    RNSBasis& operator=(const RNSBasis& other) = delete;
+
+    /**
+     * @return The fields of the channels.
+     */
+    const std::vector<GField>& getFields() const;
+
+    /**
+     * @return The moduli of the channels - the orders of the fields.
+     */
+    const std::vector<long>& getModuli() const;
+
+    /**
+     * @return The amount of channels.
+     */
+    long getChannels() const;
+
+    /**
+     * @return An amount of bits that the product of the moduli fits in.
+     */
+    const int& getBits() const;
+
+    /**
+     * Finds the mixed radix digits of a number by Garner's algorithm - the number is
+     * d[0] + d[1] * m[0] + d[2] * m[0] * m[1] + ..., with every d[i] smaller than m[i].
+     * @param residues The residues of the number, one per channel.
+     * @param stride The distance between the residues of two channels.
+     * @param digits The array to put the digits in, one per channel.
+     */
+    void mixedRadix(const long *residues, const long& stride, long *digits) const;
+
+    /**
+     * Rebuilds a number from its residues - by its mixed radix digits, multiplied out by Horner's
+     * rule in the given backing integer.
+     * @param residues The residues of the number, one per channel.
+     * @param stride The distance between the residues of two channels.
+     * @return The number modulo the product of the moduli.
+     */
+    template <typename Int>
+    Int reconstruct(const long *residues, const long& stride) const
+    {
+        assert(_bits <= GFWideTraits<Int>::BITS);
+        std::vector<long> digits(_moduli.size());
+        mixedRadix(residues, stride, digits.data());
+        Int res = Int((unsigned long) digits.back());
+        for (long i = (long) _moduli.size() - 2; i >= 0; i--)
+        {
+            res = res * Int((unsigned long) _moduli[i]) + Int((unsigned long) digits[i]);
+        }
+        return res;
+    }
+};
+
+#endif //EX1_RNSBASIS_H
@@ -0,0 +1,343 @@
+#include <algorithm>
+#include <cassert>
+#include <thread>
+#include "RNSNumber.h"
+
+/**
+ * Defines the amount of residues (numbers times channels) from which the operations of an
+ * RNSVector split the work between the hardware threads.
+ */
+const long RNS_PARALLEL_THRESHOLD = 1L << 16;
+
+/**
+ * Defines the largest modulo whose products fit in 64 bits.
+ */
+const long RNS_SMALL_MODULO = 1L << 32;
+
+/**
+ * Adds the residues of one channel.
+ * @param a The residues of the first operand.
+ * @param b The residues of the second operand.
+ * @param res The array to put the sums in.
+ * @param n The amount of residues.
+ * @param m The modulo of the channel.
+ */
+static void addChannel(const long *a, const long *b, long *res, const long& n, const long& m)
+{
+    for (long i = 0; i < n; i++)
+    {
+        unsigned long sum = (unsigned long) a[i] + (unsigned long) b[i];
+        res[i] = (long) ((sum >= (unsigned long) m) ? sum - m : sum);
+    }
+}
+
+/**
+ * Subtracts the residues of one channel.
+ * @param a The residues of the first operand.
+ * @param b The residues of the second operand.
+ * @param res The array to put the differences in.
+ * @param n The amount of residues.
+ * @param m The modulo of the channel.
+ */
+static void subtractChannel(const long *a, const long *b, long *res, const long& n, const long& m)
+{
+    for (long i = 0; i < n; i++)
+    {
+        long diff = a[i] - b[i];
+        res[i] = (diff < 0) ? diff + m : diff;
+    }
+}
+
+/**
+ * Multiplies the residues of one channel - in 64 bits when the modulo is small enough, and in 128
+ * bits otherwise.
+ * @param a The residues of the first operand.
+ * @param b The residues of the second operand.
+ * @param res The array to put the products in.
+ * @param n The amount of residues.
+ * @param m The modulo of the channel.
+ */
+static void multiplyChannel(const long *a, const long *b, long *res, const long& n, const long& m)
+{
+    if (m <= RNS_SMALL_MODULO)
+    {
+        for (long i = 0; i < n; i++)
+        {
+            res[i] = (long) ((unsigned long) a[i] * (unsigned long) b[i] % (unsigned long) m);
+        }
+        return;
+    }
+    for (long i = 0; i < n; i++)
+    {
+        res[i] = (long) ((unsigned __int128) a[i] * (unsigned long) b[i] % (unsigned long) m);
+    }
+}
+
+/**
+ * Constructor that gets a word sized number.
+ * @param n The number, may be negative.
+ * @param basis The basis of the channels.
+ */
+RNSNumber::RNSNumber(const long& n, const RNSBasis *basis) : _basis(basis)
+{
+    assert(basis != nullptr);
+    for (const long& m : basis->getModuli())
+    {
+        long residue = n % m;
+        _residues.push_back((residue < 0) ? residue + m : residue);
+    }
+}
+
+/**
+ * @return The basis of the channels.
+ */
+const RNSBasis *RNSNumber::getBasis() const
+{
+    return _basis;
+}
+
+/**
+ * @param i The channel.
+ * @return The residue of the number in the channel.
+ */
+const long& RNSNumber::getResidue(const long& i) const
+{
+    return _residues[i];
+}
+
+/**
+ * @param other A number of the same basis.
+ * @return The sum of the numbers.
+ */
+RNSNumber RNSNumber::operator+(const RNSNumber& other) const
+{
+    assert(_basis == other._basis);
+    RNSNumber res(0, _basis);
+    for (size_t i = 0; i < _residues.size(); i++)
+    {
+        addChannel(&_residues[i], &other._residues[i], &res._residues[i], 1,
+                   _basis->getModuli()[i]);
+    }
+    return res;
+}
+
+/**
+ * @param other A number of the same basis.
+ * @return The difference of the numbers.
+ */
+RNSNumber RNSNumber::operator-(const RNSNumber& other) const
+{
+    assert(_basis == other._basis);
+    RNSNumber res(0, _basis);
+    for (size_t i = 0; i < _residues.size(); i++)
+    {
+        subtractChannel(&_residues[i], &other._residues[i], &res._residues[i], 1,
+                        _basis->getModuli()[i]);
+    }
+    return res;
+}
+
+/**
+ * @param other A number of the same basis.
+ * @return The product of the numbers.
+ */
+RNSNumber RNSNumber::operator*(const RNSNumber& other) const
+{
+    assert(_basis == other._basis);
+    RNSNumber res(0, _basis);
+    for (size_t i = 0; i < _residues.size(); i++)
+    {
+        multiplyChannel(&_residues[i], &other._residues[i], &res._residues[i], 1,
+                        _basis->getModuli()[i]);
+    }
+    return res;
+}
+
+/**
+ * @param other Reference to another RNSNumber object.
+ * @return true if the bases and the residues are equal, false otherwise.
+ */
+bool RNSNumber::operator==(const RNSNumber& other) const
+{
+    return _basis == other._basis && _residues == other._residues;
+}
+
+/**
+ * @param other Reference to another RNSNumber object.
+ * @return true if the bases or the residues are different, false otherwise.
+ */
+bool RNSNumber::operator!=(const RNSNumber& other) const
+{
+    return !(*this == other);
+}
+
+/**
+ * Prints the residues and the moduli to the given stream.
+ * @param s Out stream to print to.
+ * @param obj Object to print.
+ * @return The given out stream.
+ */
+std::ostream& operator<<(std::ostream& s, const RNSNumber& obj)
+{
+    s << "RNS(";
+    for (size_t i = 0; i < obj._residues.size(); i++)
+    {
+        s << ((i > 0) ? ", " : "") << obj._residues[i] << " mod " << obj._basis->getModuli()[i];
+    }
+    s << ")";
+    return s;
+}
+
+/**
+ * Constructor of a zero vector.
+ * @param basis The basis of the channels.
+ * @param size The amount of numbers.
+ */
+RNSVector::RNSVector(const RNSBasis *basis, const long& size) : _basis(basis), _size(size)
+{
+    assert(basis != nullptr && size >= 0);
+    _data.assign(basis->getChannels() * size, 0);
+}
+
+/**
+ * Applies an operation to every channel of this vector and another one. The residues of all the
+ * channels are split into equal parts, one per hardware thread when there are enough of them, and
+ * every part is run channel by channel.
+ * @param other A vector of the same basis and size.
+ * @param func The operation.
+ * @return The result vector.
+ */
+RNSVector RNSVector::_apply(const RNSVector& other, ChannelFunction func) const
+{
+    assert(_basis == other._basis && _size == other._size);
+    RNSVector res(_basis, _size);
+    long total = (long) _data.size();
+    auto work = [this, &other, &res, func](long begin, const long& end)
+    {
+        while (begin < end)
+        {
+            long c = begin / _size;
+            long stop = std::min(end, (c + 1) * _size);
+            func(&_data[begin], &other._data[begin], &res._data[begin], stop - begin,
+                 _basis->getModuli()[c]);
+            begin = stop;
+        }
+    };
+    long threads = std::min((long) std::thread::hardware_concurrency(), total);
+    if (total < RNS_PARALLEL_THRESHOLD || threads <= 1)
+    {
+        work(0, total);
+        return res;
+    }
+    std::vector<std::thread> workers;
+    long part = (total + threads - 1) / threads;
+    for (long first = part; first < total; first += part)
+    {
+        workers.emplace_back(work, first, std::min(first + part, total));
+    }
+    work(0, std::min(part, total));
+    for (std::thread& worker : workers)
+    {
+        worker.join();
+    }
+    return res;
+}
+
+/**
+ * @return The basis of the channels.
+ */
+const RNSBasis *RNSVector::getBasis() const
+{
+    return _basis;
+}
+
+/**
+ * @return The amount of numbers.
+ */
+const long& RNSVector::getSize() const
+{
+    return _size;
+}
+
+/**
+ * @param c The channel.
+ * @return The residues of all the numbers in the channel.
+ */
+const long *RNSVector::getChannel(const long& c) const
+{
+    return _data.data() + c * _size;
+}
+
+/**
+ * @param i The index of the number.
+ * @return The number.
+ */
+RNSNumber RNSVector::get(const long& i) const
+{
+    assert(i >= 0 && i < _size);
+    RNSNumber res(0, _basis);
+    for (long c = 0; c < _basis->getChannels(); c++)
+    {
+        res._residues[c] = _data[c * _size + i];
+    }
+    return res;
+}
+
+/**
+ * @param i The index of the number.
+ * @param num A number of the same basis to put in the index.
+ */
+void RNSVector::set(const long& i, const RNSNumber& num)
+{
+    assert(i >= 0 && i < _size);
+    assert(num.getBasis() == _basis);
+    for (long c = 0; c < _basis->getChannels(); c++)
+    {
+        _data[c * _size + i] = num.getResidue(c);
+    }
+}
+
+/**
+ * @param other A vector of the same basis and size.
+ * @return The sums of the numbers.
+ */
+RNSVector RNSVector::operator+(const RNSVector& other) const
+{
+    return _apply(other, addChannel);
+}
+
+/**
+ * @param other A vector of the same basis and size.
+ * @return The differences of the numbers.
+ */
+RNSVector RNSVector::operator-(const RNSVector& other) const
+{
+    return _apply(other, subtractChannel);
+}
+
+/**
+ * @param other A vector of the same basis and size.
+ * @return The products of the numbers.
+ */
+RNSVector RNSVector::operator*(const RNSVector& other) const
+{
+    return _apply(other, multiplyChannel);
+}
+
+/**
+ * @param other Reference to another RNSVector object.
+ * @return true if the bases, the sizes and the numbers are equal, false otherwise.
+ */
+bool RNSVector::operator==(const RNSVector& other) const
+{
+    return _basis == other._basis && _size == other._size && _data == other._data;
+}
+
+/**
+ * @param other Reference to another RNSVector object.
+ * @return true if the bases, the sizes or the numbers are different, false otherwise.
+ */
+bool RNSVector::operator!=(const RNSVector& other) const
+{
+    return !(*this == other);
+}
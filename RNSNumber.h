@@ -0,0 +1,211 @@
+#ifndef EX1_RNSNUMBER_H
+#define EX1_RNSNUMBER_H
+
+#include <iostream>
+#include <vector>
+#include "RNSBasis.h"
+
+/**
+ * RNSNumber class, a number in a residue number system - its residues modulo the moduli of an
+ * RNSBasis. Sums, differences and products are calculated channel by channel in word sized
+ * integers, and the number is rebuilt (modulo the product of the moduli) only when it's needed.
+ */
+class RNSNumber
+{
+private:
+    const RNSBasis *_basis;
+    std::vector<long> _residues;
+
+    friend class RNSVector;
+
+public:
+    /**
+     * Constructor that gets a word sized number.
+     * @param n The number, may be negative.
+     * @param basis The basis of the channels.
+     */
+    RNSNumber(const long& n, const RNSBasis *basis);
+
+    /**
+     * @param n The number, in a backing integer of the wide numbers (unsigned long,
+     * unsigned __int128 or GFUInt).
+     * @param basis The basis of the channels.
+     * @return The residues of the number.
+     */
+    template <typename Int>
+    static RNSNumber fromInteger(const Int& n, const RNSBasis *basis)
+    {
+        RNSNumber res(0, basis);
+        for (long i = 0; i < basis->getChannels(); i++)
+        {
+            Int m = Int((unsigned long) basis->getModuli()[i]);
+            res._residues[i] = (long) GFWideTraits<Int>::low64(n % m);
+        }
+        return res;
+    }
+
+    /**
+     * @return The basis of the channels.
+     */
+    const RNSBasis *getBasis() const;
+
+    /**
+     * @param i The channel.
+     * @return The residue of the number in the channel.
+     */
+    const long& getResidue(const long& i) const;
+
+    /**
+     * @return The number modulo the product of the moduli, in the given backing integer - it
+     * must have at least getBasis()->getBits() bits.
+     */
+    template <typename Int>
+    Int toInteger() const
+    {
+        return _basis->reconstruct<Int>(_residues.data(), 1);
+    }
+
+    /**
+     * @param other A number of the same basis.
+     * @return The sum of the numbers.
+     */
+    RNSNumber operator+(const RNSNumber& other) const;
+
+    /**
+     * @param other A number of the same basis.
+     * @return The difference of the numbers.
+     */
+    RNSNumber operator-(const RNSNumber& other) const;
+
+    /**
+     * @param other A number of the same basis.
+     * @return The product of the numbers.
+     */
+    RNSNumber operator*(const RNSNumber& other) const;
+
+    /**
+     * @param other Reference to another RNSNumber object.
+     * @return true if the bases and the residues are equal, false otherwise.
+     */
+    bool operator==(const RNSNumber& other) const;
+
+    /**
+     * @param other Reference to another RNSNumber object.
+     * @return true if the bases or the residues are different, false otherwise.
+     */
+    bool operator!=(const RNSNumber& other) const;
+
+    /**
+     * Prints the residues and the moduli to the given stream.
+     * @param s Out stream to print to.
+     * @param obj Object to print.
+     * @return The given out stream.
+     */
+    friend std::ostream& operator<<(std::ostream& s, const RNSNumber& obj);
+};
+
+/**
+ * RNSVector class, a vector of numbers in a residue number system, kept as a structure of arrays -
+ * the residues of all the numbers in one channel are consecutive, so the channel by channel
+ * arithmetic runs over plain arrays of words, and long vectors split the work between threads.
+ */
+class RNSVector
+{
+private:
+    const RNSBasis *_basis;
+    long _size;
+    std::vector<long> _data;
+
+    /**
+     * An operation on one channel - gets the residues of both operands and of the result, their
+     * amount and the modulo of the channel.
+     */
+    typedef void (*ChannelFunction)(const long *, const long *, long *, const long&, const long&);
+
+    /**
+     * Applies an operation to every channel of this vector and another one.
+     * @param other A vector of the same basis and size.
+     * @param func The operation.
+     * @return The result vector.
+     */
+    RNSVector _apply(const RNSVector& other, ChannelFunction func) const;
+
+public:
+    /**
+     * Constructor of a zero vector.
+     * @param basis The basis of the channels.
+     * @param size The amount of numbers.
+     */
+    RNSVector(const RNSBasis *basis, const long& size);
+
+    /**
+     * @return The basis of the channels.
+     */
+    const RNSBasis *getBasis() const;
+
+    /**
+     * @return The amount of numbers.
+     */
+    const long& getSize() const;
+
+    /**
+     * @param c The channel.
+     * @return The residues of all the numbers in the channel.
+     */
+    const long *getChannel(const long& c) const;
+
+    /**
+     * @param i The index of the number.
+     * @return The number.
+     */
+    RNSNumber get(const long& i) const;
+
+    /**
+     * @param i The index of the number.
+     * @param num A number of the same basis to put in the index.
+     */
+    void set(const long& i, const RNSNumber& num);
+
+    /**
+     * @param i The index of the number.
+     * @return The number modulo the product of the moduli, in the given backing integer - it
+     * must have at least getBasis()->getBits() bits.
+     */
+    template <typename Int>
+    Int toInteger(const long& i) const
+    {
+        return _basis->reconstruct<Int>(_data.data() + i, _size);
+    }
+
+    /**
+     * @param other A vector of the same basis and size.
+     * @return The sums of the numbers.
+     */
+    RNSVector operator+(const RNSVector& other) const;
+
+    /**
+     * @param other A vector of the same basis and size.
+     * @return The differences of the numbers.
+     */
+    RNSVector operator-(const RNSVector& other) const;
+
+    /**
+     * @param other A vector of the same basis and size.
+     * @return The products of the numbers.
+     */
+    RNSVector operator*(const RNSVector& other) const;
+
+    /**
+     * @param other Reference to another RNSVector object.
+     * @return true if the bases, the sizes and the numbers are equal, false otherwise.
+     */
+    bool operator==(const RNSVector& other) const;
+
+    /**
+     * @param other Reference to another RNSVector object.
+     * @return true if the bases, the sizes or the numbers are different, false otherwise.
+     */
+    bool operator!=(const RNSVector& other) const;
+};
+
+#endif //EX1_RNSNUMBER_H